@@ -0,0 +1,86 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+
+//! Base class for the controller state of a MIDI channel, shared by all the
+//! voices of a SynthVoice. The hooks are resolved at compile time in the
+//! derived class CHANNEL, which may hide any of them. CHANNEL should
+//! befriend ChannelBase<CHANNEL> to keep its hooks private
+//!
+//! SynthVoice applies a channel message once, whatever the number of
+//! voices, and only a message that changes the state calls a hook
+template <typename CHANNEL>
+class ChannelBase
+{
+public:
+   ChannelBase() = default;
+
+   //! Get current MIDI pitch bend
+   int16_t getPitchBend() const { return pitch; }
+
+   //! Get current MIDI channel aftertouch
+   uint8_t getPressure() const { return pressure; }
+
+   //! Get current value of a MIDI control
+   uint8_t getControl(uint8_t number_) const { return control[number_]; }
+
+   //! Update MIDI pitch bend
+   void setPitchBend(int16_t value_)
+   {
+      if (value_ == pitch)
+         return;
+
+      pitch = value_;
+
+      derived().updatePitch();
+   }
+
+   //! Update MIDI channel aftertouch
+   void setPressure(uint8_t value_)
+   {
+      if (value_ == pressure)
+         return;
+
+      pressure = value_;
+
+      derived().updatePressure();
+   }
+
+   //! Update MIDI controls
+   void setControl(uint8_t number_, uint8_t value_)
+   {
+      if (value_ == control[number_])
+         return;
+
+      control[number_] = value_;
+
+      derived().updateControl(number_, value_);
+   }
+
+   //! Save or restore the controller state, see Snapshot
+   template <typename SNAPSHOT>
+   void snapshot(SNAPSHOT& s_)
+   {
+      s_.field(pitch);
+      s_.field(pressure);
+      s_.field(control);
+   }
+
+protected:
+   // Hide in the channel implementation
+   void updatePitch() {}
+   void updatePressure() {}
+   void updateControl(uint8_t number_, uint8_t value_) {}
+
+   int16_t pitch {0};
+   uint8_t pressure {0};
+   uint8_t control[128] = {0};
+
+private:
+   CHANNEL& derived() { return *static_cast<CHANNEL*>(this); }
+};
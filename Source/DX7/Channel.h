@@ -0,0 +1,77 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief DX7 MIDI channel controller state
+
+#pragma once
+
+#include <cstdint>
+
+#include "ChannelBase.h"
+
+#include "Modulation.h"
+#include "SysEx.h"
+
+namespace DX7 {
+
+//! Controller state of the MIDI channel, referenced by every voice. As in
+//! the DX7 firmware the modulation totals are computed once when an input
+//! changes and not once per voice
+class Channel : public ChannelBase<Channel>
+{
+   friend ChannelBase<Channel>;
+
+public:
+   Channel() = default;
+
+   //! A channel that never receives controller input
+   static const Channel& idle()
+   {
+      static const Channel channel{};
+      return channel;
+   }
+
+   //! Modulation source totals
+   const Modulation& getModulation() const { return modulation; }
+
+   //! Load param patch
+   void loadParam(const SysEx::Param& param_)
+   {
+      modulation.load(param_);
+   }
+
+   //! Save or restore the controller state and modulation totals, see
+   //! Snapshot
+   template <typename SNAPSHOT>
+   void snapshot(SNAPSHOT& s_)
+   {
+      ChannelBase::snapshot(s_);
+
+      s_.field(modulation);
+   }
+
+private:
+   void updatePressure()
+   {
+      modulation.rawInput(Modulation::AFTER_TOUCH, pressure);
+   }
+
+   void updateControl(uint8_t number_, uint8_t value_)
+   {
+      switch (number_)
+      {
+      case  1: modulation.rawInput(Modulation::MOD_WHEEL,      value_); break;
+      case  2: modulation.rawInput(Modulation::BREATH_CONTROL, value_); break;
+      case  4: modulation.rawInput(Modulation::FOOT_CONTROL,   value_); break;
+
+      case 64: /* sustain */ break;
+      case 65: /* portamento */ break;
+      }
+   }
+
+   Modulation modulation;
+};
+
+} // namespace DX7
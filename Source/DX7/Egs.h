@@ -10,15 +10,28 @@
 #include "EgsOpState.h"
 
 //! Model of Yamaha EGS (like the YM21290)
-class Egs : public DX::OpsAlg6<EnvGen>
+//! OPS_TYPE selects where the per-sample OPS state is held
+template <template <unsigned, typename...> class OPS_TYPE = Ops>
+class Egs : public DX::OpsAlg6<EnvGen, OPS_TYPE>
 {
+   using OpsType = DX::OpsAlg6<EnvGen, OPS_TYPE>;
+
 public:
    Egs()
+   {
+      bindOps();
+   }
+
+   //! Bind the operator state to the EGs, must be called again if the
+   //! per-sample OPS state is relocated
+   void bindOps()
    {
       for(unsigned i = 0; i < NUM_OP; ++i)
       {
-         op[i].init(getEgPointer(i));
+         op[i].init(this->getEgPointer(i));
       }
+
+      freq_changed = true;
    }
 
    // EGS inputs
@@ -27,11 +40,18 @@ public:
    void setEgsVoicePitch(uint16_t pitch16_)
    {
       // LS 2 bits are zero
-      voice_pitch14 = pitch16_ >> 2;
+      uint16_t pitch14       = pitch16_ >> 2;
+      bool     pitch_changed = pitch14 != voice_pitch14;
+
+      if (pitch_changed)
+      {
+         voice_pitch14 = pitch14;
+         freq_changed  = true;
+      }
 
       for(unsigned op_index = 0; op_index < 6; ++op_index)
       {
-         op[op_index].updateRates(voice_pitch14);
+         op[op_index].updateRates(voice_pitch14, pitch_changed);
       }
    }
 
@@ -43,7 +63,7 @@ public:
          op[op_index].env_gen->keyOn();
       }
 
-      Ops<NUM_OP,EnvGen>::keyOn();
+      OpsType::keyOn();
    }
 
    //! Release of note
@@ -58,7 +78,13 @@ public:
    //! Set pitch modulation
    void setEgsPitchMod(int16_t pitch_mod_)
    {
-      pitch_mod12 = pitch_mod_ >> 4;
+      int16_t pitch_mod = pitch_mod_ >> 4;
+
+      if (pitch_mod != pitch_mod12)
+      {
+         pitch_mod12  = pitch_mod;
+         freq_changed = true;
+      }
    }
 
    //! Set amplitude modulation (0..FF)
@@ -83,20 +109,88 @@ public:
       return true;
    }
 
+   //! Lowest current attenuation of the carrier operators, the loudest
+   //! carrier determines how audible the voice is
+   //! NOTE: This is not functionality performed by a real DX
+   uint32_t getCarrierAtten12() const
+   {
+      // Carrier operators for each algorithm, bit N-1 set for OP N
+      static const uint8_t table_carrier[32] =
+      {
+         0b000101, 0b000101, 0b001001, 0b001001, 0b010101, 0b010101, 0b000101, 0b000101,
+         0b000101, 0b001001, 0b001001, 0b000101, 0b000101, 0b000101, 0b000101, 0b000001,
+         0b000001, 0b000001, 0b011001, 0b001011, 0b011011, 0b011101, 0b011011, 0b011111,
+         0b011111, 0b001011, 0b001011, 0b100101, 0b010111, 0b100111, 0b011111, 0b111111
+      };
+
+      uint8_t  carrier = table_carrier[this->getOpsAlg()];
+      uint32_t min     = 0xFFF;
+
+      for(unsigned op_index = 0; op_index < NUM_OP; ++op_index)
+      {
+         // op[0] is OP 6
+         if ((carrier & (1 << (NUM_OP - 1 - op_index))) == 0)
+            continue;
+
+         uint32_t atten = op[op_index].env_gen->peekAtten12();
+         if (atten < min)
+            min = atten;
+      }
+
+      return min;
+   }
+
+   //! Number of operators below the attenuation at which the OPS skips
+   //! their table lookups
+   unsigned getAudibleOps() const
+   {
+      unsigned count = 0;
+
+      for(unsigned op_index = 0; op_index < NUM_OP; ++op_index)
+      {
+         if (op[op_index].env_gen->peekAtten12() < OpsType::SILENT_ATTEN_12)
+            ++count;
+      }
+
+      return count;
+   }
+
    //! Used by unit test
    int32_t getEgsAmp(unsigned op_index_)
    {
       return op[op_index_].env_gen->getAtten12();
    }
 
-   //! Send frequency value from the EGS to the OPS
+   //! Send frequency value from the EGS to the OPS, only for operators
+   //! where the voice pitch, pitch modulation or patch have changed
    void sendEgsFreq()
    {
       for(unsigned op_index = 0; op_index < 6; op_index++)
       {
-         setOpsFreq(op_index,
-                    op[op_index].computeOpsFreq14(voice_pitch14, pitch_mod12));
+         if (freq_changed or op[op_index].isFreqChanged())
+         {
+            this->setOpsFreq(op_index,
+                             op[op_index].computeOpsFreq14(voice_pitch14, pitch_mod12));
+         }
+      }
+
+      freq_changed = false;
+   }
+
+   //! Save or restore the EGS and OPS state, see Snapshot
+   template <typename SNAPSHOT>
+   void snapshot(SNAPSHOT& s_)
+   {
+      OpsType::snapshot(s_);
+
+      for(unsigned op_index = 0; op_index < NUM_OP; ++op_index)
+      {
+         op[op_index].snapshot(s_);
       }
+
+      s_.field(voice_pitch14);
+      s_.field(pitch_mod12);
+      s_.field(freq_changed);
    }
 
    static const unsigned NUM_OP = 6;
@@ -107,4 +201,5 @@ private:
    // State representing EGS registers
    uint16_t voice_pitch14{0};
    int16_t  pitch_mod12{0x0};     // DX7 @ 0x30F2
+   bool     freq_changed{true};   //!< Voice pitch or pitch modulation changed
 };
@@ -17,24 +17,32 @@ public:
    void init(EG_TYPE* env_gen_)
    {
       env_gen = env_gen_;
+
+      // Everything must be sent to the new EG and OPS state
+      freq_changed    = true;
+      rates_changed   = true;
+      amp_mod_changed = true;
    }
 
    //! Set pitch ratio from patch
    void setPitchRatio(uint16_t pitch_ratio_16_)
    {
       pitch_ratio_14 = pitch_ratio_16_ >> 2;
+      freq_changed   = true;
    }
 
    //! Set pitch mode, fixed or ratio from patch
    void setPitchFixed(bool is_pitch_fixed_)
    {
       is_pitch_fixed = is_pitch_fixed_;
+      freq_changed   = true;
    }
 
    //! Set pitch detune from patch
    void setDetune(signed detune_4_)
    {
-      detune_4 = detune_4_;
+      detune_4     = detune_4_;
+      freq_changed = true;
    }
 
    //! Set EG attenuation targete level from patch
@@ -51,12 +59,14 @@ public:
    void setEgRate(unsigned index_, uint8_t rate_6_)
    {
       eg[index_].rate_6 = rate_6_;
+      rates_changed     = true;
    }
 
    //! Set rate scaling from patch
    void setEgRateScale(uint8_t scale_3_)
    {
-      rate_scale_6 = (scale_3_ << 3) | scale_3_;
+      rate_scale_6  = (scale_3_ << 3) | scale_3_;
+      rates_changed = true;
    }
 
    //! Set amplitude modulation senitivity from patch
@@ -69,6 +79,8 @@ public:
       case 0b10: amp_mod_sens_12 = 0x555; break;
       case 0b11: amp_mod_sens_12 = 0x000; break;
       }
+
+      amp_mod_changed = true;
    }
 
 
@@ -85,9 +97,15 @@ public:
       }
    }
 
-   //! Update rates for new note
-   void updateRates(uint16_t voice_pitch14_)
+   //! Update rates for new note, only sent to the EG when the patch
+   //! rates or the voice pitch have changed
+   void updateRates(uint16_t voice_pitch14_, bool pitch_changed_ = true)
    {
+      if (not (rates_changed or pitch_changed_))
+         return;
+
+      rates_changed = false;
+
       for(unsigned i = 0; i < EG_TYPE::NUM_CONTROL; ++i)
       {
          uint8_t rate_6 = eg[i].rate_6;
@@ -101,6 +119,12 @@ public:
    //! Set amplitude modulation
    void setAmpMod(uint8_t amp_mod_8_)
    {
+      if ((amp_mod_8_ == amp_mod_8) and not amp_mod_changed)
+         return;
+
+      amp_mod_8       = amp_mod_8_;
+      amp_mod_changed = false;
+
       signed amp_mod_12 = (amp_mod_8_ << 4) | (amp_mod_8_ >> 4);
 
       amp_mod_12 -= amp_mod_sens_12;
@@ -110,9 +134,15 @@ public:
       env_gen->setAmpMod(amp_mod_12);
    }
 
+   //! Check if the frequency inputs from the patch have changed since
+   //! the last computeOpsFreq14()
+   bool isFreqChanged() const { return freq_changed; }
+
    //! Compute the 14-bit frequency value to send to the OPS
-   uint32_t computeOpsFreq14(uint16_t voice_pitch_14_, int16_t pitch_mod_12_) const
+   uint32_t computeOpsFreq14(uint16_t voice_pitch_14_, int16_t pitch_mod_12_)
    {
+      freq_changed = false;
+
       int32_t pitch_14 = pitch_ratio_14;
 
       if (is_pitch_fixed)
@@ -125,6 +155,23 @@ public:
       return pitch_14 & 0x3FFF;
    }
 
+   //! Save or restore the state, see Snapshot. The EG is saved with the
+   //! OPS state and stays bound
+   template <typename SNAPSHOT>
+   void snapshot(SNAPSHOT& s_)
+   {
+      s_.field(pitch_ratio_14);
+      s_.field(is_pitch_fixed);
+      s_.field(detune_4);
+      s_.field(rate_scale_6);
+      s_.field(eg);
+      s_.field(amp_mod_sens_12);
+      s_.field(amp_mod_8);
+      s_.field(freq_changed);
+      s_.field(rates_changed);
+      s_.field(amp_mod_changed);
+   }
+
    EG_TYPE* env_gen{};
 
 private:
@@ -140,4 +187,10 @@ private:
    uint8_t  rate_scale_6{0};
    EgState  eg[EG_TYPE::NUM_CONTROL];
    uint16_t amp_mod_sens_12{0};
+   uint8_t  amp_mod_8{0};           //!< Last amplitude modulation sent
+
+   // Inputs changed since last sent
+   bool     freq_changed{true};
+   bool     rates_changed{true};
+   bool     amp_mod_changed{true};
 };
@@ -28,6 +28,7 @@ public:
       phase[END].rate     = 0;
 
       setPhase(END);
+      schedule();
    }
 
    //! Set operator attenuation
@@ -61,22 +62,112 @@ public:
       attenuation          = phase[RELEASE].atten;
 
       setPhase(ATTACK);
+      schedule();
    }
 
    //! Release a note
    void keyOff()
    {
       if (index < RELEASE)
+      {
          setPhase(RELEASE);
+         schedule();
+      }
    }
 
    //! Check if amplitude has reached L4
    bool isComplete() const { return index == END; }
 
+   //! Current amplitude attenuation 12-bit logarithmic, excluding amplitude
+   //! modulation, without advancing the envelope
+   uint32_t peekAtten12() const { return attenuation >> (INTERNAL_BITS - OUTPUT_BITS); }
+
    //! Get amplitude attenuation sample 12-bit logarithmic
    //! 0x000 no attenuation
    //! 0xFFF full attenuation
    uint32_t getAtten12()
+   {
+      if (--count == 0)
+         step();
+      else
+         attenuation += delta;
+
+      return (attenuation >> (INTERNAL_BITS - OUTPUT_BITS)) + amp_mod_12;
+   }
+
+   //! Get a block of amplitude attenuation samples
+   void getAtten12(uint32_t* out_, unsigned n_, unsigned stride_ = 1)
+   {
+      while(n_ != 0)
+      {
+         // Samples before the next event are a linear ramp
+         unsigned ramp = count - 1 < n_ ? count - 1 : n_;
+
+         for(unsigned i = 0; i < ramp; ++i)
+         {
+            int32_t atten = attenuation + int32_t(i + 1) * delta;
+
+            out_[i * stride_] = (atten >> (INTERNAL_BITS - OUTPUT_BITS)) + amp_mod_12;
+         }
+
+         attenuation += int32_t(ramp) * delta;
+         count       -= ramp;
+         out_        += ramp * stride_;
+         n_          -= ramp;
+
+         if (n_ != 0)
+         {
+            *out_ = getAtten12();
+            out_ += stride_;
+            --n_;
+         }
+      }
+   }
+
+   //! Lowest attenuation over the next n samples, 0 if a phase change
+   //! is scheduled within them
+   uint32_t getMinAtten12(unsigned n_) const
+   {
+      if (count <= n_)
+         return 0;
+
+      int32_t end = attenuation + int32_t(n_) * delta;
+      int32_t min = end < attenuation ? end : attenuation;
+
+      return (min >> (INTERNAL_BITS - OUTPUT_BITS)) + amp_mod_12;
+   }
+
+   //! Advance by n samples without generating any output
+   void skip(unsigned n_)
+   {
+      while(n_ != 0)
+      {
+         unsigned ramp = count - 1 < n_ ? count - 1 : n_;
+
+         attenuation += int32_t(ramp) * delta;
+         count       -= ramp;
+         n_          -= ramp;
+
+         if (n_ != 0)
+         {
+            step();
+            --n_;
+         }
+      }
+   }
+
+   // For test
+   uint32_t dbgInternal() const { return attenuation; }
+   uint32_t dbgTarget() const { return target.atten; }
+   uint32_t dbgRate() const { return target.rate; }
+   unsigned dbgPhase() const { return unsigned(index); }
+
+   static const unsigned NUM_CONTROL = 4;
+
+private:
+   //! Advance the attenuation by one sample, changing phase if the
+   //! target is reached
+   void step()
    {
       if (attenuation >= target.atten)
       {
@@ -97,20 +188,47 @@ public:
          }
       }
 
-      uint32_t atten_12 = attenuation >> (INTERNAL_BITS - OUTPUT_BITS);
-
-      return atten_12 + amp_mod_12;
+      schedule();
    }
 
-   // For test
-   uint32_t dbgInternal() const { return attenuation; }
-   uint32_t dbgTarget() const { return target.atten; }
-   uint32_t dbgRate() const { return target.rate; }
-   unsigned dbgPhase() const { return unsigned(index); }
+   //! Compute the number of samples until step() must next be called,
+   //! until then the attenuation changes by a constant delta each sample
+   void schedule()
+   {
+      int32_t distance;
+      int32_t rate;
 
-   static const unsigned NUM_CONTROL = 4;
+      if (attenuation >= target.atten)
+      {
+         distance = attenuation - target.atten;
+         rate     = target.rate;
+         delta    = -rate;
+      }
+      else
+      {
+         distance = target.atten - attenuation;
+         rate     = target.rate / 4;
+         delta    = rate;
+      }
+
+      if (rate != 0)
+      {
+         // Step that reaches the target
+         count = distance == 0 ? 1 : (distance - 1) / rate + 1;
+      }
+      else if ((distance == 0) && (index != SUSTAIN) && (index != END))
+      {
+         // Already at the target, move to the next phase
+         count = 1;
+      }
+      else
+      {
+         // Target can not be reached or already reached with no next
+         // phase, either way the attenuation is constant
+         count = HOLD;
+      }
+   }
 
-private:
    void nextPhase()
    {
       if ((index != SUSTAIN) && (index != END))
@@ -135,10 +253,13 @@ private:
    static const unsigned INTERNAL_BITS = 24;
    static const unsigned OUTPUT_BITS   = 12;
    static const uint32_t MAX_ATTEN     = (1 << INTERNAL_BITS) - 1;
+   static const uint32_t HOLD          = 0xFFFFFFFF;
 
    int32_t  attenuation{MAX_ATTEN}; //!< Current attenuation (initialize to full attenuation)
    Phase    target{};               //!< Current target phase
    uint32_t amp_mod_12{0};          //!< Amplitude modulation
    Index    index{};                //!< Current phase index
+   int32_t  delta{0};               //!< Attenuation change per sample until the next event
+   uint32_t count{HOLD};            //!< Samples until the next event
    Phase    phase[NUM_PHASE];
 };
@@ -27,51 +27,69 @@ public:
    int8_t getAmpOutput() const { return output; }
 
    //! Get current pitch output value (2's comp 8-bit)
-   int8_t getPitchOutput() const { return (output * pitch_mod_sense) >> 8; }
+   int8_t getPitchOutput() const { return (output * config.pitch_mod_sense) >> 8; }
 
-   //! Configure from SysEx program
-   void load(const SysEx::Voice& patch)
+   //! Configuration from patch
+   struct Config
    {
-      // Compute LFO phase increment from LFO speed
-      // Scale 0..99 to full scale 8-bit e.g. 0..255
-      uint8_t  speed = (patch.lfo.speed * 660) >> 8;
-      unsigned scale = 11;
-
-      if (speed == 0)
-      {
-         speed = 1;                     // LFO speed 0 => 11
-      }
-      else if (speed >= 160)
+      //! Compute from SysEx program
+      void load(const SysEx::Voice& patch)
       {
-         scale += (speed - 160) >> 2;   //      LFO speed 63..99 => 1782..8670
-      }                                 // else LFO speed  1..62 =>   11..1749
+         // Compute LFO phase increment from LFO speed
+         // Scale 0..99 to full scale 8-bit e.g. 0..255
+         uint8_t  speed = (patch.lfo.speed * 660) >> 8;
+         unsigned scale = 11;
+
+         if (speed == 0)
+         {
+            speed = 1;                     // LFO speed 0 => 11
+         }
+         else if (speed >= 160)
+         {
+            scale += (speed - 160) >> 2;   //      LFO speed 63..99 => 1782..8670
+         }                                 // else LFO speed  1..62 =>   11..1749
 
-      phase_inc = scale * speed;
+         phase_inc = scale * speed;
 
 
-      // Compute LFO delay increment from LFO delay
-      // Invert 0..99 => 99..0
-      // and treat as an 7-bit floating point value _EEEMMMM
-      uint8_t  delay   = 99 - patch.lfo.delay;
-      uint8_t  exp     = 7 - (delay >> 4);
-      uint16_t mantisa = (0b10000 | (delay & 0b1111)) << 9;
-      delay_inc        = mantisa >> exp;
+         // Compute LFO delay increment from LFO delay
+         // Invert 0..99 => 99..0
+         // and treat as an 7-bit floating point value _EEEMMMM
+         uint8_t  delay   = 99 - patch.lfo.delay;
+         uint8_t  exp     = 7 - (delay >> 4);
+         uint16_t mantisa = (0b10000 | (delay & 0b1111)) << 9;
+         delay_inc        = mantisa >> exp;
 
 
-      // Scale 0..99 to full scale 8-bit e.g. 0..255
-      pitch_mod_depth = (patch.lfo.pitch_mod_depth * 660) >> 8;
+         // Scale 0..99 to full scale 8-bit e.g. 0..255
+         pitch_mod_depth = (patch.lfo.pitch_mod_depth * 660) >> 8;
 
-      // Scale 0..99 to full scale 8-bit e.g. 0..255
-      amp_mod_depth = (patch.lfo.amp_mod_depth * 660) >> 8;
+         // Scale 0..99 to full scale 8-bit e.g. 0..255
+         amp_mod_depth = (patch.lfo.amp_mod_depth * 660) >> 8;
 
-      waveform = patch.lfo.waveform;
+         waveform = patch.lfo.waveform;
 
-      // Scale 0..7 to full scale 8-bit e.g. 0..255
-      const uint8_t pitch_mod_sense_table[8] = {0, 10, 20, 33, 55, 92, 153, 255};
-      pitch_mod_sense = pitch_mod_sense_table[patch.pitch_mod_sense];
+         // Scale 0..7 to full scale 8-bit e.g. 0..255
+         const uint8_t pitch_mod_sense_table[8] = {0, 10, 20, 33, 55, 92, 153, 255};
+         pitch_mod_sense = pitch_mod_sense_table[patch.pitch_mod_sense];
 
-      sync = patch.lfo.sync;
-   }
+         sync = patch.lfo.sync;
+      }
+
+      uint16_t        phase_inc{0};              //!< DX7 var @ 0x2320
+      uint16_t        delay_inc{0};              //!< DX7 var @ 0x2322
+      SysEx::LfoWave  waveform{SysEx::TRIANGLE}; //!< DX7 var @ 0x2324
+      uint8_t         amp_mod_depth{0};          //!< DX7 var @ 0x2326
+      uint8_t         pitch_mod_depth{0};        //!< DX7 var @ 0x2325
+      uint8_t         pitch_mod_sense{0};        //!< DX7 var @ 0x2327
+      bool            sync {false};
+   };
+
+   //! Configure from an activated patch
+   void load(const Config& config_) { config = config_; }
+
+   //! Configure from SysEx program
+   void load(const SysEx::Voice& patch) { config.load(patch); }
 
    //! Start of note
    void keyOn()
@@ -79,7 +97,7 @@ public:
       delay_accum = 0;
       fade_in     = 0;
 
-      if (sync)
+      if (config.sync)
       {
          phase_accum = MAX_PHASE;
       }
@@ -89,7 +107,7 @@ public:
    void tick()
    {
       // Evaluate delay and fade-in
-      unsigned next_delay_value = delay_accum + delay_inc;
+      unsigned next_delay_value = delay_accum + config.delay_inc;
       if (next_delay_value < 0xFFFF)
       {
          // Still delayed
@@ -101,15 +119,15 @@ public:
          delay_accum = 0xFFFF;
 
          // Compute fade-in => Use MSB of delay increment for fade-in increment
-         unsigned fade_in_inc  = delay_inc > 0xFF ? delay_inc >> 8 : 1;
+         unsigned fade_in_inc  = config.delay_inc > 0xFF ? config.delay_inc >> 8 : 1;
          unsigned next_fade_in = fade_in + fade_in_inc;
          fade_in               = next_fade_in < 0xFF ? next_fade_in : 0xFF;
       }
 
       // Increment LFO phase
-      phase_accum += phase_inc;
+      phase_accum += config.phase_inc;
 
-      switch(waveform)
+      switch(config.waveform)
       {
       case SysEx::TRIANGLE:
          {
@@ -162,7 +180,7 @@ public:
          break;
 
       case SysEx::SAMPLE_AND_HOLD:
-         if ((phase_accum - MIN_PHASE) < phase_inc)
+         if ((phase_accum - MIN_PHASE) < config.phase_inc)
          {
             sample_hold_accum = sample_hold_accum * 179 + 11;
          }
@@ -170,8 +188,8 @@ public:
          break;
       }
 
-      amp_mod   = (fade_in * amp_mod_depth) >> 8;
-      pitch_mod = (fade_in * pitch_mod_depth) >> 8;
+      amp_mod   = (fade_in * config.amp_mod_depth) >> 8;
+      pitch_mod = (fade_in * config.pitch_mod_depth) >> 8;
    }
 
 private:
@@ -181,13 +199,7 @@ private:
    static const Phase MIN_PHASE = -0x8000;
 
    // Configuration from patch
-   uint16_t        phase_inc{0};              //!< DX7 var @ 0x2320
-   uint16_t        delay_inc{0};              //!< DX7 var @ 0x2322
-   SysEx::LfoWave  waveform{SysEx::TRIANGLE}; //!< DX7 var @ 0x2324
-   uint8_t         amp_mod_depth{0};          //!< DX7 var @ 0x2326
-   uint8_t         pitch_mod_depth{0};        //!< DX7 var @ 0x2325
-   uint8_t         pitch_mod_sense{0};        //!< DX7 var @ 0x2327
-   bool            sync {false};
+   Config   config{};
 
    // State
    Phase    phase_accum{MAX_PHASE};   //!< DX7 var @ 0xD7:D8
@@ -0,0 +1,419 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief Cache of rendered voice output for offline rendering
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "Snapshot.h"
+#include "TickScheduler.h"
+
+#include "Ops.h"
+#include "Patch.h"
+
+namespace DX7 {
+
+//! Cache of the output of voices for an offline render, see
+//! SynthVoice::renderCached(). The output of a voice is split into
+//! segments at the events that change the voice. A segment is recorded
+//! with the complete state of the voice at its start, which includes the
+//! patch, and the channel controllers and control tick phase. A segment
+//! that starts in exactly the same state as a recorded one replays the
+//! recording instead of rendering, even while the recording is still in
+//! progress. With oscillator key sync a repeated note starts in the same
+//! state so the whole note replays, anything that differs falls back to
+//! rendering. The output is identical to an uncached render
+template <typename VOICE, unsigned NUM_VOICES>
+class NoteCache
+{
+public:
+   //! max_bytes_ limits the memory used for recordings
+   NoteCache(size_t max_bytes_)
+      : max_bytes(max_bytes_)
+   {
+   }
+
+   //! Memory used by recordings (bytes)
+   size_t getBytes() const { return bytes; }
+
+   //! Mix the next n_ samples of the sounding voices active_ of the voice
+   //! array voice_ into out_. Voices the cache does not record are moved
+   //! to the front of active_, returns the number left for the caller to
+   //! render
+   unsigned render(VOICE*                   voice_,
+                   VOICE*                   active_[],
+                   unsigned                 count_,
+                   typename VOICE::Channel& channel_,
+                   const TickScheduler&     ticks_,
+                   int32_t*                 out_,
+                   unsigned                 n_)
+   {
+      VOICE*   replay[NUM_VOICES];
+      unsigned num_replay = 0;
+      unsigned num_live   = 0;
+
+      // Recordings are extended before the replays that may be reading
+      // them
+      for(unsigned i = 0; i < count_; ++i)
+      {
+         VOICE&   v     = *active_[i];
+         unsigned index = &v - voice_;
+
+         if (segment[index].mode == NONE)
+            begin(index, v, channel_, ticks_);
+
+         if (segment[index].mode == REPLAY)
+            replay[num_replay++] = &v;
+         else if (not mix(index, v, channel_, ticks_, out_, n_))
+            active_[num_live++] = &v;
+      }
+
+      for(unsigned i = 0; i < num_replay; ++i)
+      {
+         if (not mix(replay[i] - voice_, *replay[i], channel_, ticks_, out_, n_))
+            active_[num_live++] = replay[i];
+      }
+
+      return num_live;
+   }
+
+   //! Control tick for a sounding voice
+   void tick(unsigned index_, VOICE& voice_)
+   {
+      Segment& seg = segment[index_];
+
+      if (seg.mode == REPLAY)
+      {
+         const Entry& entry = *seg.entry;
+
+         // The tick is part of the recording
+         if ((seg.pos == entry.samples.size()) && entry.done)
+         {
+            restoreEnd(voice_, entry);
+            seg.mode = NONE;
+         }
+         return;
+      }
+
+      voice_.tick();
+
+      if (seg.mode == RECORD)
+      {
+         seg.ticked = true;
+
+         if (voice_.isMute())
+            end(index_, voice_);
+      }
+   }
+
+   //! End the segment of a voice before an event changes it, the voice
+   //! is left in the state that rendering would have left it. With live_
+   //! the voice is rendered until its next note event, after a change to
+   //! the channel the rest of a note is unlikely to repeat
+   void end(unsigned index_, VOICE& voice_, bool live_ = false)
+   {
+      Segment& seg = segment[index_];
+
+      switch(seg.mode)
+      {
+      case NONE:
+      case LIVE:
+         break;
+
+      case RECORD:
+         finish(index_, voice_);
+         break;
+
+      case REPLAY:
+         {
+            // The voice still holds the state at the start of the segment
+            TickScheduler ticks = seg.ticks;
+
+            for(unsigned offset = 0; offset < seg.pos; )
+            {
+               unsigned len = ticks.samplesToTick(seg.pos - offset);
+
+               voice_.skip(len);
+
+               if (ticks.advance(len))
+                  voice_.tick();
+
+               offset += len;
+            }
+         }
+         break;
+      }
+
+      seg.mode = live_ ? LIVE : NONE;
+   }
+
+   uint32_t hits{0};       //!< Segments replayed
+   uint32_t misses{0};     //!< Segments rendered
+   uint64_t replayed{0};   //!< Samples replayed
+
+private:
+   enum Mode : uint8_t
+   {
+      NONE,     //!< Segment starts at the next render
+      LIVE,     //!< Rendered by the caller until the segment ends
+      RECORD,   //!< Rendered and recorded
+      REPLAY    //!< Replayed from a recording
+   };
+
+   //! A recorded segment
+   struct Entry
+   {
+      std::vector<uint8_t> key;             //!< State at the start
+      std::vector<int32_t> samples;         //!< Output
+      std::vector<uint8_t> state;           //!< State at the end
+      bool                 ticked{false};   //!< The state at the end includes a tick
+      bool                 done{false};     //!< The recording is complete
+   };
+
+   //! Segment of each voice
+   struct Segment
+   {
+      Mode          mode{NONE};
+      bool          ticked{false};      //!< RECORD, ticked after the last sample
+      uint32_t      pos{0};             //!< Samples since the start
+      TickScheduler ticks{};            //!< At the start
+      Entry*        entry{nullptr};     //!< RECORD or REPLAY
+   };
+
+   //! Saves the state of a voice to compare with recordings. The
+   //! operator evaluation counters are ignored as they do not change the
+   //! output
+   class Key
+   {
+   public:
+      template <typename TYPE>
+      void field(const TYPE& value_)
+      {
+         const uint8_t* data = (const uint8_t*)&value_;
+
+         bytes.insert(bytes.end(), data, data + sizeof(TYPE));
+      }
+
+      void field(const OpsStats&) {}
+
+      void fail() {}
+
+      std::vector<uint8_t> bytes;
+   };
+
+   //! Saves the patch of a voice by value for Key
+   struct PatchValue
+   {
+      template <typename SNAPSHOT>
+      void field(SNAPSHOT& s_, const Patch*& patch_) { s_.field(*patch_); }
+   };
+
+   //! Leaves the patch of a voice unchanged, a segment ends before the
+   //! patch can change
+   struct PatchKeep
+   {
+      template <typename SNAPSHOT>
+      void field(SNAPSHOT&, const Patch*&) {}
+   };
+
+   //! Mix the next n_ samples of a voice into out_. Returns false if the
+   //! voice must be rendered by the caller
+   bool mix(unsigned                 index_,
+            VOICE&                   voice_,
+            typename VOICE::Channel& channel_,
+            const TickScheduler&     ticks_,
+            int32_t*                 out_,
+            unsigned                 n_)
+   {
+      Segment& seg = segment[index_];
+
+      for(unsigned done = 0; done < n_; )
+      {
+         switch(seg.mode)
+         {
+         case NONE:
+            {
+               // No ticks are due within the block
+               TickScheduler ticks = ticks_;
+               ticks.advance(done);
+
+               begin(index_, voice_, channel_, ticks);
+            }
+            break;
+
+         case LIVE:
+            if (done == 0)
+               return false;
+
+            voice_.render(out_ + done, n_ - done);
+            return true;
+
+         case RECORD:
+            {
+               Entry&   entry = *seg.entry;
+               unsigned n     = n_ - done;
+
+               if ((bytes + n * sizeof(int32_t)) > max_bytes)
+               {
+                  // Out of memory, end the recording here
+                  finish(index_, voice_);
+                  seg.mode = LIVE;
+                  break;
+               }
+
+               size_t pos = entry.samples.size();
+
+               entry.samples.resize(pos + n);
+               voice_.render(&entry.samples[pos], n);
+
+               for(unsigned i = 0; i < n; ++i)
+                  out_[done + i] += entry.samples[pos + i];
+
+               bytes     += n * sizeof(int32_t);
+               seg.pos   += n;
+               seg.ticked = false;
+               done       = n_;
+            }
+            break;
+
+         case REPLAY:
+            {
+               const Entry& entry = *seg.entry;
+               unsigned     n     = n_ - done;
+
+               if (seg.pos == entry.samples.size())
+               {
+                  if (entry.done)
+                  {
+                     restoreEnd(voice_, entry);
+                     seg.mode = NONE;
+                     break;
+                  }
+
+                  // The recording started in the same block and has not
+                  // got this far yet
+                  end(index_, voice_);
+                  voice_.render(out_ + done, n);
+                  return true;
+               }
+
+               if (n > (entry.samples.size() - seg.pos))
+                  n = entry.samples.size() - seg.pos;
+
+               for(unsigned i = 0; i < n; ++i)
+                  out_[done + i] += entry.samples[seg.pos + i];
+
+               seg.pos  += n;
+               done     += n;
+               replayed += n;
+
+               // A recording that ended with a tick ends on a tick here
+               // too, the state is restored by tick()
+               if ((seg.pos == entry.samples.size()) && entry.done && not entry.ticked)
+               {
+                  restoreEnd(voice_, entry);
+                  seg.mode = NONE;
+               }
+            }
+            break;
+         }
+      }
+
+      return true;
+   }
+
+   //! Start a segment, replaying it if a recording starts in the same state
+   void begin(unsigned                 index_,
+              VOICE&                   voice_,
+              typename VOICE::Channel& channel_,
+              const TickScheduler&     ticks_)
+   {
+      Segment& seg = segment[index_];
+
+      seg.pos    = 0;
+      seg.ticked = false;
+      seg.ticks  = ticks_;
+
+      Key        key;
+      PatchValue patch;
+
+      voice_.snapshot(key, patch);
+      channel_.snapshot(key);
+      key.field(ticks_);
+
+      auto& list = table[Snapshot::hash(key.bytes.data(), key.bytes.size())];
+
+      for(const auto& entry : list)
+      {
+         if (entry->key == key.bytes)
+         {
+            seg.mode  = REPLAY;
+            seg.entry = entry.get();
+            ++hits;
+            return;
+         }
+      }
+
+      ++misses;
+
+      if ((bytes + key.bytes.size()) > max_bytes)
+      {
+         seg.mode = LIVE;
+         return;
+      }
+
+      bytes += key.bytes.size();
+
+      list.emplace_back(new Entry{});
+      list.back()->key = std::move(key.bytes);
+
+      seg.mode  = RECORD;
+      seg.entry = list.back().get();
+   }
+
+   //! Complete a recording with the state of the voice
+   void finish(unsigned index_, VOICE& voice_)
+   {
+      Segment&  seg   = segment[index_];
+      Entry&    entry = *seg.entry;
+      PatchKeep patch;
+
+      Snapshot::Writer counter;
+      voice_.snapshot(counter, patch);
+
+      entry.state.resize(counter.size());
+
+      Snapshot::Writer writer{entry.state.data(), entry.state.size()};
+      voice_.snapshot(writer, patch);
+
+      entry.ticked = seg.ticked;
+      entry.done   = true;
+
+      bytes += entry.state.size();
+   }
+
+   //! Leave a voice as at the end of a recording
+   void restoreEnd(VOICE& voice_, const Entry& entry_)
+   {
+      PatchKeep patch;
+
+      Snapshot::Reader reader{entry_.state.data(), entry_.state.size()};
+      voice_.snapshot(reader, patch);
+   }
+
+   using Table = std::unordered_map<uint32_t, std::vector<std::unique_ptr<Entry>>>;
+
+   const size_t max_bytes;
+   size_t       bytes{0};
+   Table        table;
+   Segment      segment[NUM_VOICES];
+};
+
+} // namespace DX7
@@ -5,18 +5,101 @@
 
 #pragma once
 
-#include "Table_dx_exp_14.h"
-#include "Table_dx_exp_32.h"
-#include "Table_dx_log_sine_14.h"
+#include "OpsTables.h"
 
-//! Model of Yamaha OPS (like the YM21280)
+//! OPS voice computation state
+struct OpsRegs
+{
+   int32_t modulation_15{0};
+   int32_t feedback1_15{0};
+   int32_t feedback2_15{0};
+   int32_t memory_15{0};
+   uint8_t fdbk{0};
+};
+
+//! Counters for operator evaluations (wrap, take differences)
+struct OpsStats
+{
+   uint32_t op_evals{0};     //!< Operator evaluations rendered
+   uint32_t op_skipped{0};   //!< Operator evaluations skipped in culled blocks
+   uint32_t voice_culled{0}; //!< Blocks skipped with every operator silent
+};
+
+//! Per-sample OPS state held within the OPS
 template <unsigned NUM_OP, typename EG_TYPE>
+class OpsState
+{
+public:
+   EG_TYPE*  eg(unsigned op_index_)       { return &op[op_index_].eg; }
+   uint32_t& phaseAcc(unsigned op_index_) { return op[op_index_].phase_acc_32; }
+   uint32_t& phaseInc(unsigned op_index_) { return op[op_index_].phase_inc_32; }
+   OpsRegs&  regs()                       { return regs_; }
+
+private:
+   struct Op
+   {
+      EG_TYPE  eg{};
+      uint32_t phase_acc_32{0};
+      uint32_t phase_inc_32{0};
+   };
+
+   Op      op[NUM_OP];
+   OpsRegs regs_{};
+};
+
+//! Model of Yamaha OPS (like the YM21280)
+//! STATE holds the per-sample state, by default within the OPS
+//! TABLES selects the form of the lookup tables
+template <unsigned NUM_OP,
+          typename EG_TYPE,
+          typename STATE  = OpsState<NUM_OP, EG_TYPE>,
+          typename TABLES = DX::OpsTablesFull>
 class Ops
 {
 public:
+   //! Internal voice computation state
+   using Regs = OpsRegs;
+
+   using Sample = int32_t;
+
    Ops() = default;
 
-   EG_TYPE* getEgPointer(unsigned op_index_) { return &state[op_index_].eg; }
+   EG_TYPE* getEgPointer(unsigned op_index_) { return state.eg(op_index_); }
+
+   //! Access per-sample state (to relocate it)
+   STATE& getState() { return state; }
+
+   //! Access voice computation state (for external render engines)
+   Regs& getRegs() { return state.regs(); }
+
+   //! Access evaluation counters
+   OpsStats& getStats() { return stats; }
+
+   //! Access operator phase accumulator (for external render engines)
+   uint32_t& getPhaseAcc(unsigned op_index_) { return state.phaseAcc(op_index_); }
+
+   //! Get operator phase increment (for external render engines)
+   uint32_t getPhaseInc(unsigned op_index_) { return state.phaseInc(op_index_); }
+
+   //! Contribution of a sample to the output mix
+   static int32_t mix(Sample sample_) { return sample_; }
+
+   //! Save or restore the OPS state, see Snapshot
+   template <typename SNAPSHOT>
+   void snapshot(SNAPSHOT& s_)
+   {
+      s_.field(sync);
+
+      for(unsigned op_index = 0; op_index < NUM_OP; ++op_index)
+      {
+         s_.field(*state.eg(op_index));
+         s_.field(state.phaseAcc(op_index));
+         s_.field(state.phaseInc(op_index));
+      }
+
+      s_.field(state.regs());
+      s_.field(stats);
+   }
 
    //! Set the oscillator sync mode
    void setOpsSync(bool sync_)
@@ -27,7 +110,7 @@ public:
    //! Set the algorithm feedback level
    void setOpsFdbk(uint8_t feedback_)
    {
-      fdbk = (7 - feedback_) + 2;
+      state.regs().fdbk = (7 - feedback_) + 2;
    }
 
    //! Set operator frequency
@@ -38,7 +121,7 @@ public:
       // the nyquist for very low frequencies this logic has
       // been pre-folded into the 14 bits in 32 bits out
       // table used here by the table auto-generation script
-      state[op_index].phase_inc_32 = table_dx_exp_32[f14];
+      state.phaseInc(op_index) = TABLES::freq32(f14);
    }
 
    //! Start of note
@@ -48,15 +131,87 @@ public:
       {
          for(unsigned op_index = 0; op_index < NUM_OP; ++op_index)
          {
-            state[op_index].phase_acc_32 = 0;
+            state.phaseAcc(op_index) = 0;
+         }
+      }
+   }
+
+   //! Skip the next n samples if the voice would be silent throughout
+   //! Every operator must be silent for the whole block, and the voice
+   //! computation state clear so that silence can not be modulated into
+   //! sound. Then only the phase and EG need to advance.
+   //! EG_TYPE provides getMinAtten12(n) and skip(n)
+   bool cullSilent(unsigned n_)
+   {
+      const Regs& regs = state.regs();
+
+      if ((regs.modulation_15 | regs.feedback1_15 | regs.feedback2_15 | regs.memory_15) != 0)
+         return false;
+
+      if (not isSilent(n_))
+         return false;
+
+      advance(n_);
+
+      stats.op_evals   += NUM_OP * n_;
+      stats.op_skipped += NUM_OP * n_;
+      stats.voice_culled++;
+
+      return true;
+   }
+
+   //! Modulation from the feedback path
+   static int32_t feedback15(const Regs& regs_)
+   {
+      return (regs_.feedback1_15 + regs_.feedback2_15) >> regs_.fdbk;
+   }
+
+   //! True if the operators in op_mask (bit n for operator index n) are
+   //! silent for the next n samples
+   bool isSilent(unsigned n_, unsigned op_mask_ = ~0u)
+   {
+      for(unsigned op_index = 0; op_index < NUM_OP; ++op_index)
+      {
+         if (((op_mask_ & (1 << op_index)) != 0) &&
+             (state.eg(op_index)->getMinAtten12(n_) < SILENT_ATTEN_12))
+            return false;
+      }
+
+      return true;
+   }
+
+   //! Advance the phase and EG of the operators in op_mask (bit n for
+   //! operator index n) by n samples without evaluating them
+   void advance(unsigned n_, unsigned op_mask_ = ~0u)
+   {
+      for(unsigned op_index = 0; op_index < NUM_OP; ++op_index)
+      {
+         if ((op_mask_ & (1 << op_index)) != 0)
+         {
+            state.phaseAcc(op_index) += state.phaseInc(op_index) * n_;
+            state.eg(op_index)->skip(n_);
          }
       }
    }
 
+   //! The exp table is zero at and above this input so an operator with
+   //! at least this attenuation is silent whatever the sine phase
+   static const uint32_t SILENT_LOG_14   = 0x3800;
+   static const uint32_t SILENT_ATTEN_12 = SILENT_LOG_14 >> 2;
+
 protected:
    //! Simulate a single operator
    template <unsigned OP_NUMBER, unsigned SEL, bool A, bool C, bool D, unsigned LOG2_COM>
    int32_t ops()
+   {
+      return ops<OP_NUMBER, SEL, A, C, D, LOG2_COM>(state.regs());
+   }
+
+   //! Simulate a single operator using voice computation state supplied
+   //! by the caller, allowing a block render loop to hold the state in
+   //! local variables
+   template <unsigned OP_NUMBER, unsigned SEL, bool A, bool C, bool D, unsigned LOG2_COM>
+   int32_t ops(Regs& regs_)
    {
       // Documented operator number 1..N map to internal operator index N-1..0
       // the internal index follows the order of operator computation
@@ -65,51 +220,52 @@ protected:
       const unsigned op_index = NUM_OP - OP_NUMBER;
 
       // Sample sine table
-      uint32_t phase_32    = state[op_index].stepPhase();
-      uint32_t phase_12    = (phase_32 + (modulation_15 << 20)) >> (32 - 12);
-      uint32_t log_wave_14 = table_dx_log_sine_14[phase_12];
+      uint32_t phase_32    = stepPhase(op_index);
+      uint32_t phase_12    = (phase_32 + (regs_.modulation_15 << 20)) >> (32 - 12);
+      uint32_t log_wave_14 = TABLES::logSine14(phase_12);
 
       // Apply EG attenuation
-      log_wave_14 += state[op_index].eg.getAtten12() << 2;
+      log_wave_14 += state.eg(op_index)->getAtten12() << 2;
 
       // Apply algorithm compensation
       log_wave_14 += LOG2_COM << 7;
 
-      // Limit to maximum attenuation TODO fold into exp table
-      if (log_wave_14 > 0x3FFF)
-         log_wave_14 = 0x3FFF;
+      // Limit to maximum attenuation without a branch. The sum is less
+      // than 0xC000 and the exp table is zero from SILENT_LOG_14 up, so
+      // any index with bits above bit 13 set is replaced by one in the
+      // zero tail of the table
+      log_wave_14 = (log_wave_14 | -(log_wave_14 >> 14)) & 0x3FFF;
 
-      // Convert log sample to linear
-      signed output_15 = table_dx_exp_14[log_wave_14];
-      if (phase_12 >= 0x800)
-         output_15 = -output_15;
+      // Convert log sample to linear, negating for the second half wave
+      signed sign_mask = -signed(phase_12 >> 11);
+      signed output_15 = (signed(TABLES::exp14(log_wave_14)) ^ sign_mask) - sign_mask;
 
       // Mixing and routing as required by the algorithm
       signed sum_15 = 0;
-      if (C) sum_15 = memory_15;
+      if (C) sum_15 = regs_.memory_15;
       if (D) sum_15 += output_15;
 
       switch(SEL)
       {
-      case 0: modulation_15 = 0;                                     break;
-      case 1: modulation_15 = output_15;                             break;
-      case 2: modulation_15 = sum_15;                                break;
-      case 3: modulation_15 = memory_15;                             break;
-      case 4: modulation_15 = feedback1_15;                          break;
-      case 5: modulation_15 = (feedback1_15 + feedback2_15) >> fdbk; break;
+      case 0: regs_.modulation_15 = 0;                                                       break;
+      case 1: regs_.modulation_15 = output_15;                                               break;
+      case 2: regs_.modulation_15 = sum_15;                                                  break;
+      case 3: regs_.modulation_15 = regs_.memory_15;                                         break;
+      case 4: regs_.modulation_15 = regs_.feedback1_15;                                      break;
+      case 5: regs_.modulation_15 = feedback15(regs_);                                       break;
       }
 
       if (A)
       {
          // Feeedback path enabled
-         feedback2_15 = feedback1_15;
-         feedback1_15 = output_15;
+         regs_.feedback2_15 = regs_.feedback1_15;
+         regs_.feedback1_15 = output_15;
       }
 
       if (C or D)
       {
          // Memory write enable
-         memory_15 = sum_15;
+         regs_.memory_15 = sum_15;
       }
 
       // 16-bit sample returned and only used from the final operator
@@ -117,29 +273,25 @@ protected:
    }
 
 private:
-   // Externaly configured state
-   bool    sync{true};
-   uint8_t fdbk{0};
+   uint32_t stepPhase(unsigned op_index_)
+   {
+      state.phaseAcc(op_index_) += state.phaseInc(op_index_);
+      return state.phaseAcc(op_index_);
+   }
 
-   // Internal voice computation state
-   int32_t modulation_15{0};
-   int32_t feedback1_15{0};
-   int32_t feedback2_15{0};
-   int32_t memory_15{0};
+   // Externaly configured state
+   bool sync{true};
 
    // Internal operator state
-   struct State
-   {
-      EG_TYPE  eg{};
-      uint32_t phase_acc_32{0};
-      uint32_t phase_inc_32{0};
+   STATE state{};
 
-      uint32_t stepPhase()
-      {
-         phase_acc_32 += phase_inc_32;
-         return phase_acc_32;
-      }
-   };
-
-   State state[NUM_OP];
+   OpsStats stats{};
 };
+
+namespace DX {
+
+//! OPS using the compact form of the lookup tables
+template <unsigned NUM_OP, typename EG_TYPE>
+using OpsCompact = Ops<NUM_OP, EG_TYPE, OpsState<NUM_OP, EG_TYPE>, OpsTablesCompact>;
+
+} // namespace DX
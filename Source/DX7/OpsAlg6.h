@@ -33,380 +33,757 @@
 namespace DX {
 
 //! Implement the 32 DX7 OP algorithms in the YM21280 OPS
-template <typename EG_TYPE>
-class OpsAlg6 : public Ops</* NUM_OP */ 6, EG_TYPE>
+//! OPS_TYPE simulates the individual operators, by default a single voice
+template <typename EG_TYPE, template <unsigned, typename...> class OPS_TYPE = Ops>
+class OpsAlg6 : public OPS_TYPE</* NUM_OP */ 6, EG_TYPE>
 {
+   using Base   = OPS_TYPE</* NUM_OP */ 6, EG_TYPE>;
+   using Regs   = typename Base::Regs;
+   using Sample = typename Base::Sample;
+
 public:
    OpsAlg6() = default;
 
    //! Return next sample for the selected algorithm
-   int32_t operator()()
+   Sample operator()()
+   {
+      this->getStats().op_evals += 6;
+
+      return (this->*alg_ptr)(this->getRegs());
+   }
+
+   //! Get the selected algorithm
+   uint8_t getOpsAlg() const { return alg; }
+
+   //! Mix the next n samples for the selected algorithm into a buffer
+   void render(int32_t* out_, unsigned n_)
+   {
+      if (this->cullSilent(n_))
+         return;
+
+      (this->*render_ptr)(out_, n_);
+   }
+
+   //! Advance the next n samples for the selected algorithm without
+   //! rendering them. Leaves the phases, EGs and feedback state as render()
+   //! would, the feedback loop is still evaluated as it may not settle
+   void skip(unsigned n_)
    {
-      return (this->*alg_ptr)();
+      OpsAlg6* ops = this;
+
+      skip(&ops, 1, n_, [](OpsAlg6* ops_) -> OpsAlg6& { return *ops_; });
+   }
+
+   //! Advance the next n samples for a set of items as skip(), where
+   //! ops_of_(item) returns a reference to the OPS for an item. The
+   //! feedback loop of each sample depends on the last so the loops of
+   //! the items are evaluated in turn to overlap their latency
+   template <typename ITEM, typename OPS_OF>
+   static void skip(ITEM* const item_[], unsigned count_, unsigned n_, OPS_OF ops_of_)
+   {
+      static const unsigned GROUP = 8;
+
+      OpsAlg6* group[GROUP];
+      unsigned size = 0;
+
+      for(unsigned i = 0; i < count_; ++i)
+      {
+         OpsAlg6& ops = ops_of_(item_[i]);
+
+         if (ops.cullSilent(n_) or ops.skipSilentLoop(n_))
+            continue;
+
+         group[size++] = &ops;
+
+         if (size == GROUP)
+         {
+            skipGroup(group, size, n_);
+            size = 0;
+         }
+      }
+
+      if (size != 0)
+         skipGroup(group, size, n_);
+   }
+
+   //! Save or restore the OPS state, see Snapshot. The algorithm is
+   //! selected again as the implementation pointers are not saved
+   template <typename SNAPSHOT>
+   void snapshot(SNAPSHOT& s_)
+   {
+      Base::snapshot(s_);
+
+      uint8_t algorithm = alg;
+      s_.field(algorithm);
+      setOpsAlg(algorithm);
    }
 
    //! Set the algorithm
    void setOpsAlg(uint8_t algorithm)
    {
+      if (algorithm >= 32)
+         return;
+
+      alg = algorithm;
+
       switch (algorithm + 1)
       {
-      case  1: alg_ptr = &OpsAlg6::alg1;  break;
-      case  2: alg_ptr = &OpsAlg6::alg2;  break;
-      case  3: alg_ptr = &OpsAlg6::alg3;  break;
-      case  4: alg_ptr = &OpsAlg6::alg4;  break;
-      case  5: alg_ptr = &OpsAlg6::alg5;  break;
-      case  6: alg_ptr = &OpsAlg6::alg6;  break;
-      case  7: alg_ptr = &OpsAlg6::alg7;  break;
-      case  8: alg_ptr = &OpsAlg6::alg8;  break;
-      case  9: alg_ptr = &OpsAlg6::alg9;  break;
-      case 10: alg_ptr = &OpsAlg6::alg10; break;
-      case 11: alg_ptr = &OpsAlg6::alg11; break;
-      case 12: alg_ptr = &OpsAlg6::alg12; break;
-      case 13: alg_ptr = &OpsAlg6::alg13; break;
-      case 14: alg_ptr = &OpsAlg6::alg14; break;
-      case 15: alg_ptr = &OpsAlg6::alg15; break;
-      case 16: alg_ptr = &OpsAlg6::alg16; break;
-      case 17: alg_ptr = &OpsAlg6::alg17; break;
-      case 18: alg_ptr = &OpsAlg6::alg18; break;
-      case 19: alg_ptr = &OpsAlg6::alg19; break;
-      case 20: alg_ptr = &OpsAlg6::alg20; break;
-      case 21: alg_ptr = &OpsAlg6::alg21; break;
-      case 22: alg_ptr = &OpsAlg6::alg22; break;
-      case 23: alg_ptr = &OpsAlg6::alg23; break;
-      case 24: alg_ptr = &OpsAlg6::alg24; break;
-      case 25: alg_ptr = &OpsAlg6::alg25; break;
-      case 26: alg_ptr = &OpsAlg6::alg26; break;
-      case 27: alg_ptr = &OpsAlg6::alg27; break;
-      case 28: alg_ptr = &OpsAlg6::alg28; break;
-      case 29: alg_ptr = &OpsAlg6::alg29; break;
-      case 30: alg_ptr = &OpsAlg6::alg30; break;
-      case 31: alg_ptr = &OpsAlg6::alg31; break;
-      case 32: alg_ptr = &OpsAlg6::alg32; break;
+      case  1: selectAlg<&OpsAlg6::alg1,  &OpsAlg6::loop1,  /* LOOP_OPS */ 0b000001>(); break;
+      case  2: selectAlg<&OpsAlg6::alg2,  &OpsAlg6::loop2,  /* LOOP_OPS */ 0b010000>(); break;
+      case  3: selectAlg<&OpsAlg6::alg3,  &OpsAlg6::loop3,  /* LOOP_OPS */ 0b000001>(); break;
+      case  4: selectAlg<&OpsAlg6::alg4,  &OpsAlg6::loop4,  /* LOOP_OPS */ 0b000111>(); break;
+      case  5: selectAlg<&OpsAlg6::alg5,  &OpsAlg6::loop5,  /* LOOP_OPS */ 0b000001>(); break;
+      case  6: selectAlg<&OpsAlg6::alg6,  &OpsAlg6::loop6,  /* LOOP_OPS */ 0b000011>(); break;
+      case  7: selectAlg<&OpsAlg6::alg7,  &OpsAlg6::loop7,  /* LOOP_OPS */ 0b000001>(); break;
+      case  8: selectAlg<&OpsAlg6::alg8,  &OpsAlg6::loop8,  /* LOOP_OPS */ 0b000100>(); break;
+      case  9: selectAlg<&OpsAlg6::alg9,  &OpsAlg6::loop9,  /* LOOP_OPS */ 0b010000>(); break;
+      case 10: selectAlg<&OpsAlg6::alg10, &OpsAlg6::loop10, /* LOOP_OPS */ 0b001000>(); break;
+      case 11: selectAlg<&OpsAlg6::alg11, &OpsAlg6::loop11, /* LOOP_OPS */ 0b000001>(); break;
+      case 12: selectAlg<&OpsAlg6::alg12, &OpsAlg6::loop12, /* LOOP_OPS */ 0b010000>(); break;
+      case 13: selectAlg<&OpsAlg6::alg13, &OpsAlg6::loop13, /* LOOP_OPS */ 0b000001>(); break;
+      case 14: selectAlg<&OpsAlg6::alg14, &OpsAlg6::loop14, /* LOOP_OPS */ 0b000001>(); break;
+      case 15: selectAlg<&OpsAlg6::alg15, &OpsAlg6::loop15, /* LOOP_OPS */ 0b010000>(); break;
+      case 16: selectAlg<&OpsAlg6::alg16, &OpsAlg6::loop16, /* LOOP_OPS */ 0b000001>(); break;
+      case 17: selectAlg<&OpsAlg6::alg17, &OpsAlg6::loop17, /* LOOP_OPS */ 0b010000>(); break;
+      case 18: selectAlg<&OpsAlg6::alg18, &OpsAlg6::loop18, /* LOOP_OPS */ 0b001000>(); break;
+      case 19: selectAlg<&OpsAlg6::alg19, &OpsAlg6::loop19, /* LOOP_OPS */ 0b000001>(); break;
+      case 20: selectAlg<&OpsAlg6::alg20, &OpsAlg6::loop20, /* LOOP_OPS */ 0b001000>(); break;
+      case 21: selectAlg<&OpsAlg6::alg21, &OpsAlg6::loop21, /* LOOP_OPS */ 0b001000>(); break;
+      case 22: selectAlg<&OpsAlg6::alg22, &OpsAlg6::loop22, /* LOOP_OPS */ 0b000001>(); break;
+      case 23: selectAlg<&OpsAlg6::alg23, &OpsAlg6::loop23, /* LOOP_OPS */ 0b000001>(); break;
+      case 24: selectAlg<&OpsAlg6::alg24, &OpsAlg6::loop24, /* LOOP_OPS */ 0b000001>(); break;
+      case 25: selectAlg<&OpsAlg6::alg25, &OpsAlg6::loop25, /* LOOP_OPS */ 0b000001>(); break;
+      case 26: selectAlg<&OpsAlg6::alg26, &OpsAlg6::loop26, /* LOOP_OPS */ 0b000001>(); break;
+      case 27: selectAlg<&OpsAlg6::alg27, &OpsAlg6::loop27, /* LOOP_OPS */ 0b001000>(); break;
+      case 28: selectAlg<&OpsAlg6::alg28, &OpsAlg6::loop28, /* LOOP_OPS */ 0b000010>(); break;
+      case 29: selectAlg<&OpsAlg6::alg29, &OpsAlg6::loop29, /* LOOP_OPS */ 0b000001>(); break;
+      case 30: selectAlg<&OpsAlg6::alg30, &OpsAlg6::loop30, /* LOOP_OPS */ 0b000010>(); break;
+      case 31: selectAlg<&OpsAlg6::alg31, &OpsAlg6::loop31, /* LOOP_OPS */ 0b000001>(); break;
+      case 32: selectAlg<&OpsAlg6::alg32, &OpsAlg6::loop32, /* LOOP_OPS */ 0b000001>(); break;
       }
    }
 
 private:
-   int32_t alg1()
+   using AlgPtr    = Sample (OpsAlg6::*)(Regs&);
+   using RenderPtr = void (OpsAlg6::*)(int32_t*, unsigned);
+   using LoopPtr   = void (OpsAlg6::*)(Regs&);
+
+   //! Select the per-sample, block and skip implementations of an
+   //! algorithm. LOOP_OPS has bit n set for each operator index n
+   //! evaluated by LOOP
+   template <AlgPtr ALG, LoopPtr LOOP, unsigned LOOP_OPS>
+   void selectAlg()
+   {
+      alg_ptr    = ALG;
+      render_ptr = &OpsAlg6::renderAlg<ALG>;
+      loop_ptr   = LOOP;
+      loop_ops   = LOOP_OPS;
+   }
+
+   //! Block render loop, the algorithm is resolved at compile time and the
+   //! voice computation state is held locally for the duration of the block
+   template <AlgPtr ALG>
+   void renderAlg(int32_t* out_, unsigned n_)
+   {
+      Regs regs = this->getRegs();
+
+      for(unsigned i = 0; i < n_; ++i)
+      {
+         out_[i] += Base::mix((this->*ALG)(regs));
+      }
+
+      this->getRegs() = regs;
+
+      this->getStats().op_evals += 6 * n_;
+   }
+
+   //! Skip n samples if the feedback loop is silent throughout. A silent
+   //! loop outputs zero whatever its modulation so the feedback path is
+   //! clear after two samples and no operator needs to be evaluated
+   bool skipSilentLoop(unsigned n_)
+   {
+      if ((n_ < 2) || not this->isSilent(n_, loop_ops))
+         return false;
+
+      Regs& regs = this->getRegs();
+
+      regs.modulation_15 = {};
+      regs.feedback1_15  = {};
+      regs.feedback2_15  = {};
+
+      this->advance(n_);
+
+      this->getStats().op_evals   += 6 * n_;
+      this->getStats().op_skipped += 6 * n_;
+
+      return true;
+   }
+
+   //! Skip n samples evaluating only the feedback loops. Operator output
+   //! only reaches the next sample through the feedback path and the
+   //! modulation from OP1, no algorithm reads memory before writing it. So
+   //! evaluating the feedback loop alone leaves the same voice computation
+   //! state as evaluating every operator, except for memory
+   static void skipGroup(OpsAlg6* const group_[], unsigned size_, unsigned n_)
+   {
+      for(unsigned i = 0; i < n_; ++i)
+      {
+         for(unsigned j = 0; j < size_; ++j)
+         {
+            OpsAlg6* ops = group_[j];
+
+            (ops->*ops->loop_ptr)(ops->getRegs());
+         }
+      }
+
+      for(unsigned j = 0; j < size_; ++j)
+      {
+         OpsAlg6* ops = group_[j];
+
+         ops->advance(n_, ~ops->loop_ops);
+
+         ops->getStats().op_evals   += 6 * n_;
+         ops->getStats().op_skipped += (6 - __builtin_popcount(ops->loop_ops)) * n_;
+      }
+   }
+
+   Sample alg1(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<4, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+   }
+
+   Sample alg2(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<4, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<3, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+      (void) this->template ops<2, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+   }
+
+   Sample alg3(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<4, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+      (void) this->template ops<3, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+   }
+
+   Sample alg4(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<4, /* SEL */ 0, /* A */ 1, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+      (void) this->template ops<3, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+   }
+
+   Sample alg5(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01101>(regs);
+      (void) this->template ops<4, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>(regs);
+      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>(regs);
+   }
+
+   Sample alg6(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 0, /* A */ 1, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01101>(regs);
+      (void) this->template ops<4, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>(regs);
+      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>(regs);
+   }
+
+   Sample alg7(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<4, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+   }
+
+   Sample alg8(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<4, /* SEL */ 2, /* A */ 1, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+   }
+
+   Sample alg9(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<4, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<3, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+      (void) this->template ops<2, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+   }
+
+   Sample alg10(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<4, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+      (void) this->template ops<3, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+   }
+
+   Sample alg11(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 0, /* A */ 1, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<4, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+      (void) this->template ops<3, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+   }
+
+   Sample alg12(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<4, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<3, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+      (void) this->template ops<2, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+   }
+
+   Sample alg13(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 0, /* A */ 1, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<4, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+   }
+
+   Sample alg14(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 0, /* A */ 1, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<4, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+   }
+
+   Sample alg15(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<4, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<3, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+      (void) this->template ops<2, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+   }
+
+   Sample alg16(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<4, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<2, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+   }
+
+   Sample alg17(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<4, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<3, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<2, /* SEL */ 2, /* A */ 1, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+   }
+
+   Sample alg18(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<4, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<3, /* SEL */ 0, /* A */ 1, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<2, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+   }
+
+   Sample alg19(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 4, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01101>(regs);
+      (void) this->template ops<4, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>(regs);
+      (void) this->template ops<3, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>(regs);
+   }
+
+   Sample alg20(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<4, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01101>(regs);
+      (void) this->template ops<3, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<2, /* SEL */ 4, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>(regs);
+      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>(regs);
+   }
+
+   Sample alg21(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 3, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b10000>(regs);
+      (void) this->template ops<4, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>(regs);
+      (void) this->template ops<3, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<2, /* SEL */ 4, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>(regs);
+      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>(regs);
+   }
+
+   Sample alg22(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 4, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b10000>(regs);
+      (void) this->template ops<4, /* SEL */ 4, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>(regs);
+      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>(regs);
+      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>(regs);
+   }
+
+   Sample alg23(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 4, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b10000>(regs);
+      (void) this->template ops<4, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>(regs);
+      (void) this->template ops<3, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<2, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>(regs);
+      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>(regs);
+   }
+
+   Sample alg24(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 4, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b10011>(regs);
+      (void) this->template ops<4, /* SEL */ 4, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>(regs);
+      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>(regs);
+      (void) this->template ops<2, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>(regs);
+      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>(regs);
+   }
+
+   Sample alg25(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 4, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b10011>(regs);
+      (void) this->template ops<4, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>(regs);
+      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>(regs);
+      (void) this->template ops<2, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>(regs);
+      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>(regs);
+   }
+
+   Sample alg26(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 0, /* A */ 1, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<4, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01101>(regs);
+      (void) this->template ops<3, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<2, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>(regs);
+      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>(regs);
+   }
+
+   Sample alg27(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<4, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01101>(regs);
+      (void) this->template ops<3, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<2, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>(regs);
+      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>(regs);
+   }
+
+   Sample alg28(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01101>(regs);
+      (void) this->template ops<5, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<4, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>(regs);
+      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>(regs);
+   }
+
+   Sample alg29(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b10000>(regs);
+      (void) this->template ops<4, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>(regs);
+      (void) this->template ops<2, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>(regs);
+      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>(regs);
+   }
+
+   Sample alg30(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b10000>(regs);
+      (void) this->template ops<5, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<4, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>(regs);
+      (void) this->template ops<2, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>(regs);
+      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>(regs);
+   }
+
+   Sample alg31(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b10011>(regs);
+      (void) this->template ops<4, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>(regs);
+      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>(regs);
+      (void) this->template ops<2, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>(regs);
+      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>(regs);
+   }
+
+   Sample alg32(Regs& regs)
+   {
+      (void) this->template ops<6, /* SEL */ 0, /* A */ 1, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b10101>(regs);
+      (void) this->template ops<5, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10101>(regs);
+      (void) this->template ops<4, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10101>(regs);
+      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10101>(regs);
+      (void) this->template ops<2, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10101>(regs);
+      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10101>(regs);
+   }
+
+   // Feedback loops, the operators between the SEL 5 route of the feedback
+   // path and the operator that writes it. Followed by the routing of OP1,
+   // the modulation that OP1 passes to the next sample
+
+   void loop1(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<4, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>();
-      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>();
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = Base::feedback15(regs);   // OP1 SEL 5
    }
 
-   int32_t alg2()
+   void loop2(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<4, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<3, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>();
-      (void) this->template ops<2, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>();
+      regs.modulation_15 = Base::feedback15(regs);   // OP3 SEL 5
+      (void) this->template ops<2, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = {};                        // OP1 SEL 0
    }
 
-   int32_t alg3()
+   void loop3(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<4, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>();
-      (void) this->template ops<3, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>();
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = Base::feedback15(regs);   // OP1 SEL 5
    }
 
-   int32_t alg4()
+   void loop4(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<4, /* SEL */ 0, /* A */ 1, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>();
-      (void) this->template ops<3, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>();
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<4, /* SEL */ 0, /* A */ 1, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>(regs);
+      regs.modulation_15 = Base::feedback15(regs);   // OP1 SEL 5
    }
 
-   int32_t alg5()
+   void loop5(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01101>();
-      (void) this->template ops<4, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>();
-      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>();
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = Base::feedback15(regs);   // OP1 SEL 5
    }
 
-   int32_t alg6()
+   void loop6(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 0, /* A */ 1, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01101>();
-      (void) this->template ops<4, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>();
-      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>();
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      (void) this->template ops<5, /* SEL */ 0, /* A */ 1, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01101>(regs);
+      regs.modulation_15 = Base::feedback15(regs);   // OP1 SEL 5
    }
 
-   int32_t alg7()
+   void loop7(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<4, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>();
-      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>();
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = Base::feedback15(regs);   // OP1 SEL 5
    }
 
-   int32_t alg8()
+   void loop8(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<4, /* SEL */ 2, /* A */ 1, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>();
-      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>();
+      regs.modulation_15 = Base::feedback15(regs);   // OP5 SEL 5
+      (void) this->template ops<4, /* SEL */ 2, /* A */ 1, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = {};                        // OP1 SEL 0
    }
 
-   int32_t alg9()
+   void loop9(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<4, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<3, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>();
-      (void) this->template ops<2, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>();
+      regs.modulation_15 = Base::feedback15(regs);   // OP3 SEL 5
+      (void) this->template ops<2, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = {};                        // OP1 SEL 0
    }
 
-   int32_t alg10()
+   void loop10(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<4, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>();
-      (void) this->template ops<3, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>();
+      regs.modulation_15 = Base::feedback15(regs);   // OP4 SEL 5
+      (void) this->template ops<3, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = {};                        // OP1 SEL 0
    }
 
-   int32_t alg11()
+   void loop11(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 0, /* A */ 1, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<4, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>();
-      (void) this->template ops<3, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>();
+      (void) this->template ops<6, /* SEL */ 0, /* A */ 1, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = Base::feedback15(regs);   // OP1 SEL 5
    }
 
-   int32_t alg12()
+   void loop12(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<4, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<3, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>();
-      (void) this->template ops<2, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>();
+      regs.modulation_15 = Base::feedback15(regs);   // OP3 SEL 5
+      (void) this->template ops<2, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = {};                        // OP1 SEL 0
    }
 
-   int32_t alg13()
+   void loop13(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 0, /* A */ 1, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<4, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>();
-      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>();
+      (void) this->template ops<6, /* SEL */ 0, /* A */ 1, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = Base::feedback15(regs);   // OP1 SEL 5
    }
 
-   int32_t alg14()
+   void loop14(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 0, /* A */ 1, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<4, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>();
-      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>();
+      (void) this->template ops<6, /* SEL */ 0, /* A */ 1, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = Base::feedback15(regs);   // OP1 SEL 5
    }
 
-   int32_t alg15()
+   void loop15(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<4, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<3, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01000>();
-      (void) this->template ops<2, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01000>();
+      regs.modulation_15 = Base::feedback15(regs);   // OP3 SEL 5
+      (void) this->template ops<2, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = {};                        // OP1 SEL 0
    }
 
-   int32_t alg16()
+   void loop16(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<4, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<2, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>();
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = Base::feedback15(regs);   // OP1 SEL 5
    }
 
-   int32_t alg17()
+   void loop17(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<4, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<3, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<2, /* SEL */ 2, /* A */ 1, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>();
+      regs.modulation_15 = Base::feedback15(regs);   // OP3 SEL 5
+      (void) this->template ops<2, /* SEL */ 2, /* A */ 1, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = {};                        // OP1 SEL 0
    }
 
-   int32_t alg18()
+   void loop18(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<4, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<3, /* SEL */ 0, /* A */ 1, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<2, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>();
+      regs.modulation_15 = Base::feedback15(regs);   // OP4 SEL 5
+      (void) this->template ops<3, /* SEL */ 0, /* A */ 1, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = {};                        // OP1 SEL 0
    }
 
-   int32_t alg19()
+   void loop19(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 4, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01101>();
-      (void) this->template ops<4, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>();
-      (void) this->template ops<3, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>();
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = Base::feedback15(regs);   // OP1 SEL 5
    }
 
-   int32_t alg20()
+   void loop20(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<4, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01101>();
-      (void) this->template ops<3, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<2, /* SEL */ 4, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>();
-      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>();
+      regs.modulation_15 = Base::feedback15(regs);   // OP4 SEL 5
+      (void) this->template ops<3, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = {};                        // OP1 SEL 0
    }
 
-   int32_t alg21()
+   void loop21(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 1, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 3, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b10000>();
-      (void) this->template ops<4, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>();
-      (void) this->template ops<3, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<2, /* SEL */ 4, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>();
-      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>();
+      regs.modulation_15 = Base::feedback15(regs);   // OP4 SEL 5
+      (void) this->template ops<3, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = {};                        // OP1 SEL 0
    }
 
-   int32_t alg22()
+   void loop22(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 4, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b10000>();
-      (void) this->template ops<4, /* SEL */ 4, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>();
-      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>();
-      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>();
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = Base::feedback15(regs);   // OP1 SEL 5
    }
 
-   int32_t alg23()
+   void loop23(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 4, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b10000>();
-      (void) this->template ops<4, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>();
-      (void) this->template ops<3, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<2, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>();
-      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>();
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = Base::feedback15(regs);   // OP1 SEL 5
    }
 
-   int32_t alg24()
+   void loop24(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 4, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b10011>();
-      (void) this->template ops<4, /* SEL */ 4, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>();
-      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>();
-      (void) this->template ops<2, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>();
-      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>();
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = Base::feedback15(regs);   // OP1 SEL 5
    }
 
-   int32_t alg25()
+   void loop25(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 4, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b10011>();
-      (void) this->template ops<4, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>();
-      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>();
-      (void) this->template ops<2, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>();
-      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>();
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = Base::feedback15(regs);   // OP1 SEL 5
    }
 
-   int32_t alg26()
+   void loop26(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 0, /* A */ 1, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<4, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01101>();
-      (void) this->template ops<3, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<2, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>();
-      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>();
+      (void) this->template ops<6, /* SEL */ 0, /* A */ 1, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = Base::feedback15(regs);   // OP1 SEL 5
    }
 
-   int32_t alg27()
+   void loop27(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 2, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<4, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01101>();
-      (void) this->template ops<3, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<2, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>();
-      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>();
+      regs.modulation_15 = Base::feedback15(regs);   // OP4 SEL 5
+      (void) this->template ops<3, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = {};                        // OP1 SEL 0
    }
 
-   int32_t alg28()
+   void loop28(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b01101>();
-      (void) this->template ops<5, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<4, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>();
-      (void) this->template ops<2, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b01101>();
+      regs.modulation_15 = Base::feedback15(regs);   // OP6 SEL 5
+      (void) this->template ops<5, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = {};                        // OP1 SEL 0
    }
 
-   int32_t alg29()
+   void loop29(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b10000>();
-      (void) this->template ops<4, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>();
-      (void) this->template ops<2, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>();
-      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>();
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = Base::feedback15(regs);   // OP1 SEL 5
    }
 
-   int32_t alg30()
+   void loop30(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 5, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b10000>();
-      (void) this->template ops<5, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<4, /* SEL */ 1, /* A */ 0, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>();
-      (void) this->template ops<2, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>();
-      return this->template ops<1, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10000>();
+      regs.modulation_15 = Base::feedback15(regs);   // OP6 SEL 5
+      (void) this->template ops<5, /* SEL */ 1, /* A */ 1, /* C */ 1, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = {};                        // OP1 SEL 0
    }
 
-   int32_t alg31()
+   void loop31(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>();
-      (void) this->template ops<5, /* SEL */ 0, /* A */ 0, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b10011>();
-      (void) this->template ops<4, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>();
-      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>();
-      (void) this->template ops<2, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>();
-      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10011>();
+      (void) this->template ops<6, /* SEL */ 1, /* A */ 1, /* C */ 0, /* D */ 0, /* LOG2_COM */ 0b00000>(regs);
+      regs.modulation_15 = Base::feedback15(regs);   // OP1 SEL 5
    }
 
-   int32_t alg32()
+   void loop32(Regs& regs)
    {
-      (void) this->template ops<6, /* SEL */ 0, /* A */ 1, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b10101>();
-      (void) this->template ops<5, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10101>();
-      (void) this->template ops<4, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10101>();
-      (void) this->template ops<3, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10101>();
-      (void) this->template ops<2, /* SEL */ 0, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10101>();
-      return this->template ops<1, /* SEL */ 5, /* A */ 0, /* C */ 1, /* D */ 1, /* LOG2_COM */ 0b10101>();
+      (void) this->template ops<6, /* SEL */ 0, /* A */ 1, /* C */ 0, /* D */ 1, /* LOG2_COM */ 0b10101>(regs);
+      regs.modulation_15 = Base::feedback15(regs);   // OP1 SEL 5
    }
 
-   int32_t (OpsAlg6::*alg_ptr)() {&OpsAlg6::alg1};
+   uint8_t   alg{0};
+   AlgPtr    alg_ptr{&OpsAlg6::alg1};
+   RenderPtr render_ptr{&OpsAlg6::renderAlg<&OpsAlg6::alg1>};
+   LoopPtr   loop_ptr{&OpsAlg6::loop1};
+   uint8_t   loop_ops{0b000001};
 };
 
 } // namespace DX
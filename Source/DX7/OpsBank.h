@@ -0,0 +1,94 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief Structure-of-arrays storage for the per-sample OPS state of many voices
+
+#pragma once
+
+#include <cstdint>
+
+#include "Ops.h"
+
+namespace DX {
+
+//! Per-sample OPS state for a block of voices
+template <unsigned NUM_OP, typename EG_TYPE>
+struct OpsBankBlock
+{
+   static const unsigned NUM_VOICES = 8;
+
+   uint32_t phase_acc_32[NUM_OP][NUM_VOICES]{};
+   uint32_t phase_inc_32[NUM_OP][NUM_VOICES]{};
+   OpsRegs  regs[NUM_VOICES]{};
+   EG_TYPE  eg[NUM_OP][NUM_VOICES]{};
+};
+
+//! Per-sample OPS state for one voice that is held in an OpsBank
+template <unsigned NUM_OP, typename EG_TYPE>
+class OpsBankSlot
+{
+public:
+   using Block = OpsBankBlock<NUM_OP, EG_TYPE>;
+
+   //! Bind to a voice within a block
+   void attach(Block* block_, unsigned index_)
+   {
+      eg_ptr        = &block_->eg[0][index_];
+      phase_acc_ptr = &block_->phase_acc_32[0][index_];
+      phase_inc_ptr = &block_->phase_inc_32[0][index_];
+      regs_ptr      = &block_->regs[index_];
+   }
+
+   EG_TYPE*  eg(unsigned op_index_)       { return &eg_ptr[op_index_ * STRIDE]; }
+   uint32_t& phaseAcc(unsigned op_index_) { return phase_acc_ptr[op_index_ * STRIDE]; }
+   uint32_t& phaseInc(unsigned op_index_) { return phase_inc_ptr[op_index_ * STRIDE]; }
+   OpsRegs&  regs()                       { return *regs_ptr; }
+
+private:
+   static const unsigned STRIDE = Block::NUM_VOICES;
+
+   // Only pointers are held so that stores to the state can not alias
+   // the location of the state, allowing the addresses to be kept in
+   // registers in the render loop
+   EG_TYPE*  eg_ptr{};
+   uint32_t* phase_acc_ptr{};
+   uint32_t* phase_inc_ptr{};
+   OpsRegs*  regs_ptr{};
+};
+
+//! OPS with per-sample state held in an OpsBank
+template <unsigned NUM_OP, typename EG_TYPE>
+using OpsBanked = Ops<NUM_OP, EG_TYPE, OpsBankSlot<NUM_OP, EG_TYPE>>;
+
+//! Per-sample OPS state for a bank of voices
+//! The state that is touched for every sample of every voice is kept in
+//! per-operator arrays indexed by voice, separate from the control rate
+//! and patch state of each voice. Voices are grouped in blocks so that
+//! all the state for one voice can be addressed from a single pointer
+template <unsigned NUM_VOICES, unsigned NUM_OP, typename EG_TYPE>
+class OpsBank
+{
+public:
+   using Slot  = OpsBankSlot<NUM_OP, EG_TYPE>;
+   using Block = OpsBankBlock<NUM_OP, EG_TYPE>;
+
+   OpsBank() = default;
+
+   //! Bind a voice slot to the state at an index in the bank
+   void attach(Slot& slot_, unsigned index_)
+   {
+      slot_.attach(&block[index_ / Block::NUM_VOICES], index_ % Block::NUM_VOICES);
+   }
+
+   //! Size of the per-sample state for the whole bank (bytes)
+   static constexpr size_t hotSize() { return sizeof(block); }
+
+private:
+   static const unsigned NUM_BLOCKS = (NUM_VOICES + Block::NUM_VOICES - 1) / Block::NUM_VOICES;
+
+   Block block[NUM_BLOCKS];
+};
+
+} // namespace DX
@@ -0,0 +1,199 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief OPS simulation with each SIMD lane simulating a different voice
+
+#pragma once
+
+#include "OpsAlg6.h"
+#include "OpsSimd.h"
+
+#include "Table_dx_exp_14.h"
+#include "Table_dx_log_sine_14.h"
+
+namespace DX {
+
+//! Replays EG output pre-computed for each lane by the scalar EGs
+template <typename VEC>
+class LaneEg
+{
+public:
+   using Vec = VEC;
+
+   LaneEg() = default;
+
+   void start(const uint32_t* atten12_) { next = atten12_; }
+
+   Vec getAtten12()
+   {
+      Vec atten12 = Vec::load(next);
+      next += OpsSimd::MAX_LANES;
+      return atten12;
+   }
+
+private:
+   const uint32_t* next{};
+};
+
+
+//! Model of Yamaha OPS (like the YM21280) with one voice per lane
+//! Mirrors the scalar Ops implementation so the output is bit exact
+template <unsigned NUM_OP, typename EG_TYPE>
+class OpsLanes
+{
+public:
+   using Vec    = typename EG_TYPE::Vec;
+   using Sample = Vec;
+
+   //! Internal voice computation state
+   struct Regs
+   {
+      Vec modulation_15;
+      Vec feedback1_15;
+      Vec feedback2_15;
+      Vec memory_15;
+      Vec fdbk;
+   };
+
+   OpsLanes() = default;
+
+   //! Access voice computation state
+   Regs& getRegs() { return regs; }
+
+   //! Silent voices are culled by OpsSimd before they are grouped
+   bool cullSilent(unsigned) { return false; }
+
+   //! Modulation from the feedback path
+   static Vec feedback15(const Regs& regs_)
+   {
+      return (regs_.feedback1_15 + regs_.feedback2_15).sra(regs_.fdbk);
+   }
+
+   //! Evaluations are counted for each voice by OpsSimd
+   OpsStats& getStats() { return stats; }
+
+   //! Contribution of a sample to the output mix
+   static int32_t mix(Sample sample_) { return sample_.hsum(); }
+
+   //! Load state for a group of voices
+   void load(const OpsSimd::Job& job_)
+   {
+      for(unsigned op_index = 0; op_index < NUM_OP; ++op_index)
+      {
+         state[op_index].phase_acc_32 = Vec::load(job_.phase_acc_32[op_index]);
+         state[op_index].phase_inc_32 = Vec::load(job_.phase_inc_32[op_index]);
+         state[op_index].eg.start(&job_.atten12[op_index][0][0]);
+      }
+
+      regs.modulation_15 = Vec::load(job_.modulation_15);
+      regs.feedback1_15  = Vec::load(job_.feedback1_15);
+      regs.feedback2_15  = Vec::load(job_.feedback2_15);
+      regs.memory_15     = Vec::load(job_.memory_15);
+      regs.fdbk          = Vec::load(job_.fdbk);
+   }
+
+   //! Store state for a group of voices
+   void store(OpsSimd::Job& job_) const
+   {
+      for(unsigned op_index = 0; op_index < NUM_OP; ++op_index)
+      {
+         state[op_index].phase_acc_32.store(job_.phase_acc_32[op_index]);
+      }
+
+      regs.modulation_15.store(job_.modulation_15);
+      regs.feedback1_15.store(job_.feedback1_15);
+      regs.feedback2_15.store(job_.feedback2_15);
+      regs.memory_15.store(job_.memory_15);
+   }
+
+protected:
+   //! Simulate a single operator for all lanes
+   template <unsigned OP_NUMBER, unsigned SEL, bool A, bool C, bool D, unsigned LOG2_COM>
+   Vec ops(Regs& regs_)
+   {
+      const unsigned op_index = NUM_OP - OP_NUMBER;
+
+      // Sample sine table
+      Vec phase_32    = state[op_index].stepPhase();
+      Vec phase_12    = (phase_32 + regs_.modulation_15.template sll<20>()).template srl<32 - 12>();
+      Vec log_wave_14 = Vec::template gather<4096>(table_dx_log_sine_14, phase_12);
+
+      // Apply EG attenuation
+      log_wave_14 = log_wave_14 + state[op_index].eg.getAtten12().template sll<2>();
+
+      // Apply algorithm compensation
+      log_wave_14 = log_wave_14 + Vec::splat(LOG2_COM << 7);
+
+      // Limit to maximum attenuation
+      log_wave_14 = Vec::min(log_wave_14, Vec::splat(0x3FFF));
+
+      // Convert log sample to linear and negate second half of the cycle
+      Vec output_15 = Vec::template gather<16384>(table_dx_exp_14, log_wave_14);
+      Vec negate    = phase_12.template sll<32 - 12>().template sra<31>();
+      output_15     = (output_15 ^ negate) - negate;
+
+      // Mixing and routing as required by the algorithm
+      Vec sum_15 = Vec::splat(0);
+      if (C) sum_15 = regs_.memory_15;
+      if (D) sum_15 = sum_15 + output_15;
+
+      switch(SEL)
+      {
+      case 0: regs_.modulation_15 = Vec::splat(0);                                             break;
+      case 1: regs_.modulation_15 = output_15;                                                 break;
+      case 2: regs_.modulation_15 = sum_15;                                                    break;
+      case 3: regs_.modulation_15 = regs_.memory_15;                                           break;
+      case 4: regs_.modulation_15 = regs_.feedback1_15;                                        break;
+      case 5: regs_.modulation_15 = feedback15(regs_);                                         break;
+      }
+
+      if (A)
+      {
+         regs_.feedback2_15 = regs_.feedback1_15;
+         regs_.feedback1_15 = output_15;
+      }
+
+      if (C or D)
+      {
+         regs_.memory_15 = sum_15;
+      }
+
+      return sum_15.template sll<1>();
+   }
+
+   Regs regs{};
+
+private:
+   struct State
+   {
+      EG_TYPE eg{};
+      Vec     phase_acc_32;
+      Vec     phase_inc_32;
+
+      Vec stepPhase()
+      {
+         phase_acc_32 = phase_acc_32 + phase_inc_32;
+         return phase_acc_32;
+      }
+   };
+
+   State    state[NUM_OP];
+   OpsStats stats{};
+};
+
+
+//! Kernel rendering up to CHUNK samples for a group of voices
+template <typename VEC>
+void opsLanesKernel(OpsSimd::Job& job_, int32_t* out_, unsigned n_)
+{
+   OpsAlg6<LaneEg<VEC>, OpsLanes> engine;
+
+   engine.setOpsAlg(job_.alg);
+   engine.load(job_);
+   engine.render(out_, n_);
+   engine.store(job_);
+}
+
+} // namespace DX
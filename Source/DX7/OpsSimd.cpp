@@ -0,0 +1,21 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+#include "OpsSimd.h"
+
+using namespace DX;
+
+OpsSimd::Isa OpsSimd::detect()
+{
+#if defined(__x86_64__) || defined(__i386__)
+   if ((kernel_avx2 != nullptr) && __builtin_cpu_supports("avx2"))
+      return AVX2;
+
+   if ((kernel_sse4 != nullptr) && __builtin_cpu_supports("sse4.1"))
+      return SSE4;
+#endif
+
+   return SCALAR;
+}
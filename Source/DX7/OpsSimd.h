@@ -0,0 +1,218 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief Multi-voice OPS render engine
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace DX {
+
+//! Renders groups of voices that share an algorithm in parallel, one voice
+//! per SIMD lane. The instruction set is selected at run-time and when no
+//! SIMD support is available each voice is rendered by its own scalar OPS
+class OpsSimd
+{
+public:
+   enum Isa : uint8_t { SCALAR, SSE4, AVX2 };
+
+   static const unsigned NUM_OP    = 6;
+   static const unsigned NUM_ALG   = 32;
+   static const unsigned MAX_LANES = 8;
+   static const unsigned CHUNK     = 32;  //!< Samples per kernel invocation
+
+   //! State for a group of voices laid out one voice per lane
+   struct Job
+   {
+      uint8_t  alg;
+      uint32_t phase_acc_32[NUM_OP][MAX_LANES];
+      uint32_t phase_inc_32[NUM_OP][MAX_LANES];
+      int32_t  modulation_15[MAX_LANES];
+      int32_t  feedback1_15[MAX_LANES];
+      int32_t  feedback2_15[MAX_LANES];
+      int32_t  memory_15[MAX_LANES];
+      int32_t  fdbk[MAX_LANES];
+      uint32_t atten12[NUM_OP][CHUNK][MAX_LANES];  //!< EG output for each sample
+   };
+
+   using Kernel = void (*)(Job& job_, int32_t* out_, unsigned n_);
+
+   //! Best instruction set supported by this build and CPU
+   static Isa detect();
+
+   //! Get the instruction set in use
+   static Isa getIsa() { return isa(); }
+
+   //! Select an instruction set, limited to what is detected (for test and benchmark)
+   static void setIsa(Isa isa_) { isa() = isa_ < detect() ? isa_ : detect(); }
+
+   //! Mix the next n samples for a set of items into a buffer where
+   //! ops_of_(item) returns a reference to the OPS for an item
+   template <typename ITEM, typename OPS_OF>
+   static void render(ITEM* const item_[], unsigned count_, int32_t* out_, unsigned n_,
+                      OPS_OF ops_of_)
+   {
+      using OPS = std::remove_reference_t<decltype(ops_of_(item_[0]))>;
+
+      Kernel   kernel = getKernel(isa());
+      unsigned lanes  = isa() == AVX2 ? 8 : 4;
+
+      if (kernel == nullptr)
+      {
+         for(unsigned i = 0; i < count_; ++i)
+            ops_of_(item_[i]).render(out_, n_);
+         return;
+      }
+
+      uint32_t alg_used = 0;
+
+      for(unsigned i = 0; i < count_; ++i)
+         alg_used |= 1 << ops_of_(item_[i]).getOpsAlg();
+
+      for(uint8_t alg = 0; alg < NUM_ALG; ++alg)
+      {
+         if ((alg_used & (1 << alg)) == 0)
+            continue;
+
+         OPS*     group[MAX_LANES];
+         unsigned size = 0;
+
+         for(unsigned i = 0; i < count_; ++i)
+         {
+            OPS& ops = ops_of_(item_[i]);
+
+            if (ops.getOpsAlg() != alg)
+               continue;
+
+            if (ops.cullSilent(n_))
+               continue;
+
+            group[size++] = &ops;
+
+            if (size == lanes)
+            {
+               renderGroup(kernel, group, size, out_, n_);
+               size = 0;
+            }
+         }
+
+         if (size > lanes / 2)
+         {
+            renderGroup(kernel, group, size, out_, n_);
+         }
+         else
+         {
+            // Too few voices to fill the lanes
+            for(unsigned i = 0; i < size; ++i)
+               group[i]->render(out_, n_);
+         }
+      }
+   }
+
+private:
+   static Isa& isa()
+   {
+      // The SSE4.1 kernel lacks a table gather and is not faster than the
+      // scalar path, so it is only used when explicitly selected
+      static Isa selected = detect() == AVX2 ? AVX2 : SCALAR;
+      return selected;
+   }
+
+   static Kernel getKernel(Isa isa_)
+   {
+      switch(isa_)
+      {
+      case SCALAR: return nullptr;
+      case SSE4:   return kernel_sse4;
+      case AVX2:   return kernel_avx2;
+      }
+      return nullptr;
+   }
+
+   //! Render a group of OPS that share an algorithm
+   template <typename OPS>
+   static void renderGroup(Kernel kernel_, OPS* const group_[], unsigned size_,
+                           int32_t* out_, unsigned n_)
+   {
+      Job job;
+
+      job.alg = group_[0]->getOpsAlg();
+
+      // Unused lanes have no phase increment and maximum attenuation so
+      // contribute silence
+      for(unsigned lane = 0; lane < MAX_LANES; ++lane)
+      {
+         bool used = lane < size_;
+
+         for(unsigned op = 0; op < NUM_OP; ++op)
+         {
+            job.phase_acc_32[op][lane] = used ? group_[lane]->getPhaseAcc(op) : 0;
+            job.phase_inc_32[op][lane] = used ? group_[lane]->getPhaseInc(op) : 0;
+         }
+
+         if (used)
+         {
+            const auto& regs = group_[lane]->getRegs();
+
+            job.modulation_15[lane] = regs.modulation_15;
+            job.feedback1_15[lane]  = regs.feedback1_15;
+            job.feedback2_15[lane]  = regs.feedback2_15;
+            job.memory_15[lane]     = regs.memory_15;
+            job.fdbk[lane]          = regs.fdbk;
+         }
+         else
+         {
+            job.modulation_15[lane] = 0;
+            job.feedback1_15[lane]  = 0;
+            job.feedback2_15[lane]  = 0;
+            job.memory_15[lane]     = 0;
+            job.fdbk[lane]          = 0;
+
+            for(unsigned op = 0; op < NUM_OP; ++op)
+               for(unsigned t = 0; t < CHUNK; ++t)
+                  job.atten12[op][t][lane] = 0x3FFF;
+         }
+      }
+
+      for(unsigned offset = 0; offset < n_; offset += CHUNK)
+      {
+         unsigned n = n_ - offset < CHUNK ? n_ - offset : CHUNK;
+
+         // The EGs are independent of the OPS output so can be run ahead
+         for(unsigned lane = 0; lane < size_; ++lane)
+         {
+            for(unsigned op = 0; op < NUM_OP; ++op)
+            {
+               group_[lane]->getEgPointer(op)->getAtten12(&job.atten12[op][0][lane], n, MAX_LANES);
+            }
+         }
+
+         (*kernel_)(job, out_ + offset, n);
+      }
+
+      for(unsigned lane = 0; lane < size_; ++lane)
+      {
+         for(unsigned op = 0; op < NUM_OP; ++op)
+            group_[lane]->getPhaseAcc(op) = job.phase_acc_32[op][lane];
+
+         group_[lane]->getStats().op_evals += NUM_OP * n_;
+
+         auto& regs = group_[lane]->getRegs();
+
+         regs.modulation_15 = job.modulation_15[lane];
+         regs.feedback1_15  = job.feedback1_15[lane];
+         regs.feedback2_15  = job.feedback2_15[lane];
+         regs.memory_15     = job.memory_15[lane];
+      }
+   }
+
+   // Kernels are nullptr when not supported by the build
+   static const Kernel kernel_sse4;
+   static const Kernel kernel_avx2;
+};
+
+} // namespace DX
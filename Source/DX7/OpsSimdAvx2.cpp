@@ -0,0 +1,22 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// NOTE: This file is built with AVX2 code generation enabled and must only
+//       instantiate templates that are private to it
+
+#include "OpsSimd.h"
+
+#if defined(__AVX2__)
+
+#include "OpsLanes.h"
+#include "VecAvx2.h"
+
+const DX::OpsSimd::Kernel DX::OpsSimd::kernel_avx2 = DX::opsLanesKernel<DX::VecAvx2>;
+
+#else
+
+const DX::OpsSimd::Kernel DX::OpsSimd::kernel_avx2 = nullptr;
+
+#endif
@@ -0,0 +1,22 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// NOTE: This file is built with SSE4.1 code generation enabled and must only
+//       instantiate templates that are private to it
+
+#include "OpsSimd.h"
+
+#if defined(__SSE4_1__)
+
+#include "OpsLanes.h"
+#include "VecSse4.h"
+
+const DX::OpsSimd::Kernel DX::OpsSimd::kernel_sse4 = DX::opsLanesKernel<DX::VecSse4>;
+
+#else
+
+const DX::OpsSimd::Kernel DX::OpsSimd::kernel_sse4 = nullptr;
+
+#endif
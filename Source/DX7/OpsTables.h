@@ -0,0 +1,61 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief Lookup table access for the OPS
+
+#pragma once
+
+#include <cstdint>
+
+#include "Table_dx_exp_14.h"
+#include "Table_dx_exp_32.h"
+#include "Table_dx_log_sine_14.h"
+#include "Table_dx_exp_mant_12.h"
+#include "Table_dx_log_sine_quarter_14.h"
+
+namespace DX {
+
+//! Full size tables with one entry for every input (104 KiB)
+struct OpsTablesFull
+{
+   //! 14-bit log frequency to 32-bit phase increment
+   static uint32_t freq32(uint32_t f14_) { return table_dx_exp_32[f14_]; }
+
+   //! 12-bit phase to 14-bit log abs sine
+   static uint32_t logSine14(uint32_t phase_12_) { return table_dx_log_sine_14[phase_12_]; }
+
+   //! 14-bit log attenuation to 15-bit linear amplitude
+   static uint32_t exp14(uint32_t log_14_) { return table_dx_exp_14[log_14_]; }
+};
+
+//! Compact tables that fit in the L1 cache of a host or leave SRAM free
+//! on a microcontroller (4 KiB), the results are identical to OpsTablesFull
+struct OpsTablesCompact
+{
+   static uint32_t freq32(uint32_t f14_)
+   {
+      uint32_t exp22 = (table_dx_exp_mant_12[f14_ & 0x3FF] << (f14_ >> 10)) >> 5;
+
+      // Re-use of the top 0xC00 table values for very low frequencies
+      return f14_ < 0x3400 ? exp22 << 13 : exp22 >> 3;
+   }
+
+   static uint32_t logSine14(uint32_t phase_12_)
+   {
+      // The second quarter of each half wave mirrors the first
+      uint32_t mirror = (phase_12_ & 0x400) != 0 ? 0x3FF : 0;
+
+      return table_dx_log_sine_quarter_14[(phase_12_ ^ mirror) & 0x3FF];
+   }
+
+   static uint32_t exp14(uint32_t log_14_)
+   {
+      uint32_t index_14 = 0x3FFF - log_14_;
+
+      return (table_dx_exp_mant_12[index_14 & 0x3FF] << (index_14 >> 10)) >> 13;
+   }
+};
+
+} // namespace DX
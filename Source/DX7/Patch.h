@@ -0,0 +1,366 @@
+//------------------------------------------------------------------------------
+// The data in this file is a derivative of data reverse engineered from the
+// DX7 firmware ROM published on AJXS github project. That publicly
+// available project does not contain a copyright notice or any mention of
+// permissions or restrictions that apply to the use of the data. However,
+// according to law that does not necessarily mean that the data is free from
+// restrictions on its use. At the time of publication, the copyright holder
+// is probably Yamaha. If the copyright holder wishes to retrospectively declare
+// reasonable and legal restrictions on the data, then either those restrictions
+// must be obeyed or this file shouled be deleted.
+//
+// The statements above shall be included in all copies or substantial portions
+// of the data.
+//
+// THE DATA IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE DATA OR THE USE OR OTHER DEALINGS IN THE
+// DATA.
+//------------------------------------------------------------------------------
+//
+// \brief DX7 firmware simulation - activated voice patch
+//
+// Credit to AJXS for his excellent disassembly of the DX7 firmware ROM
+
+#pragma once
+
+#include <cstring>
+
+#include "SysEx.h"
+
+#include "Lfo.h"
+#include "PitchEg.h"
+
+namespace DX7 {
+
+//! A voice patch converted to the form used by the firmware and the EGS.
+//! The conversion is done once per patch and the result is immutable, so
+//! one instance is referenced by every voice that is playing the patch
+class Patch
+{
+public:
+   Patch() = default;
+
+   Patch(const SysEx::Voice& voice_)
+   {
+      activate(voice_);
+   }
+
+   //! Implement PATCH_ACTIVATE
+   void activate(const SysEx::Voice& voice_)
+   {
+      for(unsigned i = 0; i < SysEx::NUM_OP; i++)
+      {
+         const SysEx::Op& sysex_op = voice_.op[i];
+
+         patchActivateOperatorEgRate(op[i], sysex_op);
+         patchActivateOperatorEgLevel(op[i], sysex_op);
+         patchActivateOperatorKbdScaling(op[i], sysex_op);
+         patchActivateOperatorKbdVelSens(op[i], sysex_op);
+         patchActivateOperatorPitch(op[i], sysex_op);
+         patchActivateOperatorKbdRateScaling(op[i], sysex_op);
+         patchActivateOperatorDetune(op[i], sysex_op);
+
+         op[i].enable = (voice_.operator_on & (1 << i)) != 0;
+      }
+
+      pitch_eg.load(voice_);
+      patchActivateAlgMode(voice_);
+      lfo.load(voice_);
+
+      transpose = voice_.transpose;
+   }
+
+   //! Load a patch activated at build time (see Table_dx7_patch.py)
+   void load(const uint8_t* image_)
+   {
+      for(unsigned i = 0; i < SysEx::NUM_OP; i++)
+      {
+         const uint8_t* image_op = image_ + i * IMAGE_OP_SIZE;
+
+         for(unsigned j = 0; j < 4; ++j)
+         {
+            op[i].eg_rate_6[j]  = image_op[j];
+            op[i].eg_atten_6[j] = image_op[4 + j];
+         }
+
+         op[i].pitch_ratio_16 = get16(image_op + 8);
+         op[i].pitch_fixed    = image_op[10] != 0;
+         op[i].detune         = int8_t(image_op[11]);
+         op[i].rate_scale     = image_op[12];
+         op[i].amp_mod_sens   = image_op[13];
+         op[i].enable         = image_op[14] != 0;
+         op[i].sens           = get16(image_op + 16);
+
+         memcpy(op[i].kbd_scaling, image_op + 18, sizeof(op[i].kbd_scaling));
+      }
+
+      const uint8_t* image_voice = image_ + SysEx::NUM_OP * IMAGE_OP_SIZE;
+
+      alg       = image_voice[0];
+      feedback  = image_voice[1];
+      osc_sync  = image_voice[2] != 0;
+      transpose = image_voice[3];
+
+      lfo.phase_inc       = get16(image_voice + 4);
+      lfo.delay_inc       = get16(image_voice + 6);
+      lfo.waveform        = SysEx::LfoWave(image_voice[8]);
+      lfo.amp_mod_depth   = image_voice[9];
+      lfo.pitch_mod_depth = image_voice[10];
+      lfo.pitch_mod_sense = image_voice[11];
+      lfo.sync            = image_voice[12] != 0;
+
+      for(unsigned j = 0; j < 4; ++j)
+      {
+         pitch_eg.rate[j]  = image_voice[16 + j];
+         pitch_eg.level[j] = image_voice[20 + j];
+      }
+   }
+
+   static const unsigned IMAGE_SIZE    = 512;   //!< Bytes per build time patch
+   static const unsigned IMAGE_OP_SIZE = 64;    //!< Bytes per operator
+
+   //! Patch with all operators disabled, for voices that have not
+   //! been given a program
+   static const Patch& silent()
+   {
+      static const Patch patch{};
+      return patch;
+   }
+
+   //! Key pitch for a MIDI note
+   static uint8_t keyPitch(uint8_t note_)
+   {
+      static const uint8_t table_key_pitch[128] =
+      {
+         0x00, 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08,
+         0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x10, 0x11, 0x12,
+         0x14, 0x15, 0x16, 0x18, 0x19, 0x1A, 0x1C, 0x1D,
+         0x1E, 0x20, 0x21, 0x22, 0x24, 0x25, 0x26, 0x28,
+         0x29, 0x2A, 0x2C, 0x2D, 0x2E, 0x30, 0x31, 0x32,
+         0x34, 0x35, 0x36, 0x38, 0x39, 0x3A, 0x3C, 0x3D,
+         0x3E, 0x40, 0x41, 0x42, 0x44, 0x45, 0x46, 0x48,
+         0x49, 0x4A, 0x4C, 0x4D, 0x4E, 0x50, 0x51, 0x52,
+         0x54, 0x55, 0x56, 0x58, 0x59, 0x5A, 0x5C, 0x5D,
+         0x5E, 0x60, 0x61, 0x62, 0x64, 0x65, 0x66, 0x68,
+         0x69, 0x6A, 0x6C, 0x6D, 0x6E, 0x70, 0x71, 0x72,
+         0x74, 0x75, 0x76, 0x78, 0x79, 0x7A, 0x7C, 0x7D,
+         0x7E, 0x80, 0x81, 0x82, 0x84, 0x85, 0x86, 0x88,
+         0x89, 0x8A, 0x8C, 0x8D, 0x8E, 0x90, 0x91, 0x92,
+         0x94, 0x95, 0x96, 0x98, 0x99, 0x9A, 0x9C, 0x9D,
+         0x9E, 0xA0, 0xA1, 0xA2, 0xA4, 0xA5, 0xA6, 0xA8
+      };
+
+      return table_key_pitch[note_];
+   }
+
+   //! Operator configuration
+   struct Op
+   {
+      uint8_t  eg_rate_6[4]{};
+      uint8_t  eg_atten_6[4]{};
+      uint16_t pitch_ratio_16{0};
+      bool     pitch_fixed{false};
+      int8_t   detune{0};
+      uint8_t  rate_scale{0};
+      uint8_t  amp_mod_sens{0};
+      bool     enable{false};
+      uint16_t sens{0};                  //!< M_PATCH_OP_SENS
+      uint8_t  kbd_scaling[43]{};        //!< M_OPERATOR_KEYBOARD_SCALING
+   };
+
+   Op                 op[SysEx::NUM_OP];
+   uint8_t            alg{0};
+   uint8_t            feedback{0};
+   bool               osc_sync{false};
+   uint8_t            transpose{0};
+   Lfo::Config        lfo;
+   PitchEg<1>::Config pitch_eg;
+
+private:
+   //! Little-endian 16-bit value from a build time patch
+   static uint16_t get16(const uint8_t* byte_)
+   {
+      return byte_[0] | (byte_[1] << 8);
+   }
+
+   //! Implement PATCH_ACTIVATE_OPERATOR_EG_RATE
+   static void patchActivateOperatorEgRate(Op& op_, const SysEx::Op& sysex_op_)
+   {
+      for(unsigned i = 0; i < 4; ++i)
+      {
+         op_.eg_rate_6[i] = (sysex_op_.eg_amp.rate[i] * 164) >> 8;
+      }
+   }
+
+   //! Implement PATCH_ACTIVATE_OPERATOR_EG_LEVEL
+   static void patchActivateOperatorEgLevel(Op& op_, const SysEx::Op& sysex_op_)
+   {
+      for(unsigned i = 0; i < 4; ++i)
+      {
+         // Some ROM voices have out of range levels
+         uint8_t level = sysex_op_.eg_amp.level[i];
+         if (level > 99)
+            level = 99;
+
+         op_.eg_atten_6[i] = table_log[level] >> 1;
+      }
+   }
+
+   //! Implement PATCH_ACTIVATE_OPERATOR_KBD_SCALING
+   static void patchActivateOperatorKbdScaling(Op& op_, const SysEx::Op& op)
+   {
+      unsigned breakpoint  = keyPitch(op.kbd_lvl_scl_bpt + 20) >> 2;
+      unsigned depth_left  = (op.kbd_lvl_scl_lft_depth * 660) >> 8;
+      unsigned depth_right = (op.kbd_lvl_scl_rgt_depth * 660) >> 8;
+
+      // The curves are indexed up to 38 from the breakpoint but the ROM
+      // tables are only 36 long. The last 3 entries are the bytes that
+      // follow each table in the ROM (TABLE_KBD_SCALING_CURVE_LIN and
+      // TABLE_LOG)
+      static const uint8_t table_kbd_scaling_curve_exp[39] =
+      {
+         0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+         0x06, 0x07, 0x08, 0x09, 0x0B, 0x0E,
+         0x10, 0x13, 0x17, 0x1C, 0x21, 0x27,
+         0x2F, 0x39, 0x43, 0x50, 0x5F, 0x71,
+         0x86, 0xA0, 0xBE, 0xE0, 0xFF, 0xFF,
+         0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+         0x00, 0x08, 0x10
+      };
+
+      static const uint8_t table_kbd_scaling_curve_lin[39] =
+      {
+         0x00, 0x08, 0x10, 0x18, 0x20, 0x28,
+         0x30, 0x38, 0x40, 0x48, 0x50, 0x58,
+         0x60, 0x68, 0x70, 0x78, 0x80, 0x88,
+         0x90, 0x98, 0xA0, 0xA8, 0xB2, 0xB8,
+         0xC0, 0xC8, 0xD0, 0xD8, 0xE0, 0xE8,
+         0xF0, 0xF8, 0xFF, 0xFF, 0xFF, 0xFF,
+         0x7F, 0x7A, 0x76
+      };
+
+      // Note, sign is "opposite" as lower values are louder
+
+      signed         left_sign  = op.kbd_lvl_scl_lft_curve >= 2 ? -1 : +1;
+      bool           left_lin   = op.kbd_lvl_scl_lft_curve == 0 || op.kbd_lvl_scl_lft_curve == 3;
+      const uint8_t* left_curve = left_lin ? table_kbd_scaling_curve_lin
+                                           : table_kbd_scaling_curve_exp;
+
+      signed         right_sign  = op.kbd_lvl_scl_rgt_curve >= 2 ? -1 : +1;
+      bool           right_lin   = op.kbd_lvl_scl_rgt_curve == 0 || op.kbd_lvl_scl_rgt_curve == 3;
+      const uint8_t* right_curve = right_lin ? table_kbd_scaling_curve_lin
+                                             : table_kbd_scaling_curve_exp;
+
+      unsigned out_level = table_log[op.out_level];
+
+      for(signed note = 1; note <= 43; ++note)
+      {
+         signed offset = note - breakpoint;
+
+         signed curve = offset <= 0 ? left_curve[-offset] * depth_left * left_sign
+                                    : right_curve[offset] * depth_right * right_sign;
+
+         signed note_level = (out_level + (curve >> 8)) << 1;
+
+         if (note_level < 0)
+            note_level = 0;
+         else if (note_level > 0xFF)
+            note_level = 0xFF;
+
+         op_.kbd_scaling[note - 1] = note_level;
+      }
+   }
+
+   //! Implement PATCH_ACTIVATE_OPERATOR_VEL_SENS
+   static void patchActivateOperatorKbdVelSens(Op& op_, const SysEx::Op& op)
+   {
+      op_.sens = (8 - op.key_vel_sense) * 0x1E0;
+   }
+
+   //! Implement PATCH_ACTIVATE_OPERATOR_PITCH
+   static void patchActivateOperatorPitch(Op& op_, const SysEx::Op& op)
+   {
+      if (op.osc_mode == SysEx::RATIO)
+      {
+         static const uint16_t table_op_freq_coarse[32] =
+         {
+            0xF000, 0x0000, 0x1000, 0x195C, 0x2000, 0x2528, 0x295C, 0x2CEC,
+            0x3000, 0x32B8, 0x3528, 0x375A, 0x395C, 0x3B34, 0x3CEC, 0x3E84,
+            0x4000, 0x4168, 0x42B8, 0x43F8, 0x4528, 0x4648, 0x475A, 0x4860,
+            0x495C, 0x4A4C, 0x4B34, 0x4C14, 0x4CEC, 0x4DBA, 0x4E84, 0x4F44
+         };
+
+         static const uint16_t table_op_freq_fine[100] =
+         {
+            0x000, 0x03A, 0x075, 0x0AE, 0x0E7, 0x120, 0x158, 0x18F, 0x1C6, 0x1FD,
+            0x233, 0x268, 0x29D, 0x2D2, 0x306, 0x339, 0x36D, 0x39F, 0x3D2, 0x403,
+            0x435, 0x466, 0x497, 0x4C7, 0x4F7, 0x526, 0x555, 0x584, 0x5B2, 0x5E0,
+            0x60E, 0x63B, 0x668, 0x695, 0x6C1, 0x6ED, 0x719, 0x744, 0x76F, 0x799,
+            0x7C4, 0x7EE, 0x818, 0x841, 0x86A, 0x893, 0x8BC, 0x8E4, 0x90C, 0x934,
+            0x95C, 0x983, 0x9AA, 0x9D1, 0x9F7, 0xA1D, 0xA43, 0xA69, 0xA8F, 0xAB4,
+            0xAD9, 0xAFE, 0xB22, 0xB47, 0xB6B, 0xB8F, 0xBB2, 0xBD6, 0xBF9, 0xC1C,
+            0xC3F, 0xC62, 0xC84, 0xCA7, 0xCC9, 0xCEA, 0xD0C, 0xD2E, 0xD4F, 0xD70,
+            0xD91, 0xDB2, 0xDD2, 0xDF3, 0xE13, 0xE33, 0xE53, 0xE72, 0xE92, 0xEB1,
+            0xED0, 0xEEF, 0xF0E, 0xF2D, 0xF4C, 0xF6A, 0xF88, 0xFA6, 0xFC4, 0xFE2
+         };
+
+         op_.pitch_fixed    = false;
+         op_.pitch_ratio_16 = table_op_freq_coarse[op.osc_freq_coarse] +
+                              table_op_freq_fine[op.osc_freq_fine] +
+                              0x232C;
+      }
+      else
+      {
+         static const uint16_t table_op_freq_fixed[4] =
+         {
+            0x0000, 0x3526, 0x6A4C, 0x9F74
+         };
+
+         op_.pitch_fixed    = true;
+         op_.pitch_ratio_16 = table_op_freq_fixed[op.osc_freq_coarse & 0b11] +
+                              op.osc_freq_fine * 136 +
+                              0x16AC;
+      }
+   }
+
+   //! Implement PATCH_ACTIVATE_OPERATOR_KBD_RATE_SCALING
+   static void patchActivateOperatorKbdRateScaling(Op& op_, const SysEx::Op& op)
+   {
+      op_.rate_scale   = op.kbd_rate_scale;
+      op_.amp_mod_sens = op.amp_mod_sense;
+   }
+
+   //! Implement PATCH_ACTIVATE_OPERATOR_DETUNE
+   static void patchActivateOperatorDetune(Op& op_, const SysEx::Op& op)
+   {
+      op_.detune = op.osc_detune - 7;
+   }
+
+   //! Implement PATCH_ACTIVATE_ALG_MODE
+   void patchActivateAlgMode(const SysEx::Voice& voice_)
+   {
+      osc_sync = voice_.osc_sync;
+      alg      = voice_.alg;
+      feedback = voice_.feedback;
+   }
+
+   static constexpr uint8_t table_log[100] =
+   {
+      0x7F, 0x7A, 0x76, 0x72, 0x6E, 0x6B, 0x68, 0x66, 0x64, 0x62,
+      0x60, 0x5E, 0x5C, 0x5A, 0x58, 0x56, 0x55, 0x54, 0x52, 0x51,
+      0x4F, 0x4E, 0x4D, 0x4C, 0x4B, 0x4A, 0x49, 0x48, 0x47, 0x46,
+      0x45, 0x44, 0x43, 0x42, 0x41, 0x40, 0x3F, 0x3E, 0x3D, 0x3C,
+      0x3B, 0x3A, 0x39, 0x38, 0x37, 0x36, 0x35, 0x34, 0x33, 0x32,
+      0x31, 0x30, 0x2F, 0x2E, 0x2D, 0x2C, 0x2B, 0x2A, 0x29, 0x28,
+      0x27, 0x26, 0x25, 0x24, 0x23, 0x22, 0x21, 0x20, 0x1F, 0x1E,
+      0x1D, 0x1C, 0x1B, 0x1A, 0x19, 0x18, 0x17, 0x16, 0x15, 0x14,
+      0x13, 0x12, 0x11, 0x10, 0x0F, 0x0E, 0x0D, 0x0C, 0x0B, 0x0A,
+      0x09, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00
+   };
+};
+
+} // namespace DX7
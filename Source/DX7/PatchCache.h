@@ -0,0 +1,159 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief Cache of activated voice patches
+
+#pragma once
+
+#include <cstdint>
+
+#include "Patch.h"
+#include "SysEx.h"
+
+namespace DX7 {
+
+//! Bounded cache of activated patches so that selecting a recently used
+//! program is a lookup and not a PATCH_ACTIVATE. Entries are keyed by the
+//! program number and a hash of the packed patch, so re-loading a bank
+//! with different contents misses. The least recently used entry is
+//! replaced on a miss
+template <unsigned SIZE = 16>
+class PatchCache
+{
+public:
+   PatchCache() = default;
+
+   //! Get the activated form of a packed program, the reference remains
+   //! valid until SIZE other programs have been selected. When the program
+   //! was activated at build time, image_ avoids a PATCH_ACTIVATE on a miss
+   const Patch& find(unsigned             number_,
+                     const SysEx::Packed& packed_,
+                     const uint8_t*       image_ = nullptr)
+   {
+      uint32_t hash = hashPacked(packed_);
+
+      Entry* lru = &entry[0];
+
+      ++clock;
+
+      for(unsigned i = 0; i < SIZE; ++i)
+      {
+         Entry& e = entry[i];
+
+         if ((e.last_use != 0) && (e.number == number_) && (e.hash == hash))
+         {
+            e.last_use = clock;
+            ++hits;
+            return e.patch;
+         }
+
+         if (e.last_use < lru->last_use)
+            lru = &e;
+      }
+
+      ++misses;
+
+      lru->number   = number_;
+      lru->hash     = hash;
+      lru->last_use = clock;
+
+      if (image_ != nullptr)
+      {
+         lru->patch.load(image_);
+      }
+      else
+      {
+         SysEx::Voice voice;
+         voice = packed_;
+         lru->patch.activate(voice);
+      }
+
+      return lru->patch;
+   }
+
+   //! Discard all entries
+   void flush()
+   {
+      for(unsigned i = 0; i < SIZE; ++i)
+         entry[i].last_use = 0;
+   }
+
+   //! Index of the entry in use that holds an activated patch, SIZE if
+   //! there is none
+   unsigned indexOf(const Patch* patch_) const
+   {
+      for(unsigned i = 0; i < SIZE; ++i)
+      {
+         if ((entry[i].last_use != 0) && (&entry[i].patch == patch_))
+            return i;
+      }
+
+      return SIZE;
+   }
+
+   //! Activated patch of an entry in use, nullptr if unused
+   const Patch* getPatch(unsigned index_) const
+   {
+      if ((index_ >= SIZE) || (entry[index_].last_use == 0))
+         return nullptr;
+
+      return &entry[index_].patch;
+   }
+
+   //! Save or restore the cache, see Snapshot. Only the entries in use
+   //! are saved
+   template <typename SNAPSHOT>
+   void snapshot(SNAPSHOT& s_)
+   {
+      s_.field(clock);
+      s_.field(hits);
+      s_.field(misses);
+
+      for(unsigned i = 0; i < SIZE; ++i)
+      {
+         Entry& e = entry[i];
+
+         s_.field(e.last_use);
+
+         if (e.last_use != 0)
+         {
+            s_.field(e.hash);
+            s_.field(e.number);
+            s_.field(e.patch);
+         }
+      }
+   }
+
+   uint32_t hits{0};     //!< Programs found activated
+   uint32_t misses{0};   //!< Programs that had to be activated
+
+private:
+   //! FNV-1a hash of the packed patch bytes
+   static uint32_t hashPacked(const SysEx::Packed& packed_)
+   {
+      const uint8_t* byte = (const uint8_t*)&packed_;
+      uint32_t       hash = 0x811C9DC5;
+
+      for(unsigned i = 0; i < sizeof(SysEx::Packed); ++i)
+      {
+         hash = (hash ^ byte[i]) * 0x01000193;
+      }
+
+      return hash;
+   }
+
+   struct Entry
+   {
+      uint32_t last_use{0};   //!< 0 => unused
+      uint32_t hash{0};
+      unsigned number{0};
+      Patch    patch{};
+   };
+
+   uint32_t clock{0};
+   Entry    entry[SIZE];
+};
+
+} // namespace DX7
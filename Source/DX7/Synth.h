@@ -5,11 +5,15 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstring>
 #include <unistd.h>
 
+#include "Snapshot.h"
 #include "SynthVoiceSysEx.h"
 
+#include "Patch.h"
+#include "PatchCache.h"
 #include "SysEx.h"
 #include "Voice.h"
 
@@ -17,12 +21,18 @@
 #include "Table_dx7_rom_2.h"
 #include "Table_dx7_rom_3.h"
 #include "Table_dx7_rom_4.h"
+#include "Table_dx7_patch_1.h"
+#include "Table_dx7_patch_2.h"
+#include "Table_dx7_patch_3.h"
+#include "Table_dx7_patch_4.h"
 
 namespace DX7 {
 
-template <unsigned N, unsigned AMP_N = N>
-class Synth : public SynthVoice<Voice,N,AMP_N>
+template <unsigned N, unsigned AMP_N = N, typename VOICE = Voice<>>
+class Synth : public SynthVoice<VOICE,N,AMP_N>
 {
+   friend Snapshot;
+
 public:
    Synth()
    {
@@ -30,6 +40,30 @@ public:
       memcpy(internal_patches, table_dx7_rom_1, sizeof(internal_patches));
    }
 
+   //! Size of a snapshot of the current state (bytes)
+   size_t getStateSize()
+   {
+      return Snapshot::size(*this);
+   }
+
+   //! Write a snapshot of the complete engine state, the voices, the
+   //! patches they play, the controllers, the queued events and the SYSEX
+   //! parser, into a buffer. Returns the size written, 0 if the buffer is
+   //! too small. Between blocks on the render thread with no MIDI input
+   size_t saveState(uint8_t* buffer_, size_t size_)
+   {
+      return Snapshot::save(*this, stateId(), buffer_, size_);
+   }
+
+   //! Restore a snapshot written by saveState() of a synth of the same
+   //! type, rendering continues exactly as from the saved synth. Returns
+   //! false, leaving the state unchanged, if the snapshot is damaged or
+   //! from a different version or configuration
+   bool restoreState(const uint8_t* buffer_, size_t size_)
+   {
+      return Snapshot::restore(*this, stateId(), buffer_, size_);
+   }
+
 private:
    enum State : uint8_t
    {
@@ -58,7 +92,7 @@ private:
    };
 
    //! Handle a SYSEX byte
-   void sysEx(uint8_t byte) override
+   void sysExEvent(uint8_t byte) override
    {
       if (byte == 0xF0)
       {
@@ -149,14 +183,17 @@ private:
 
       case STATE_PATCH_EDIT_CSUM:
          // TODO check the checksum
+         activateEditPatch(/* update */ false);
          for(unsigned i = 0; i < N; ++i)
-            updateVoice(i, 0, /* update */ false);
+            this->voice[i].loadProgram(patch);
          state = STATE_IGNORE;
          break;
 
 
       case STATE_PATCH_INT_DATA:
          {
+            internal_is_rom = false;
+
             auto buffer = (uint8_t*) &internal_patches;
             buffer[index++] = byte;
             if (index == size)
@@ -166,6 +203,7 @@ private:
 
       case STATE_PATCH_INT_CSUM:
          // TODO check the checksum
+         patch_number = NO_PATCH;
          state = STATE_IGNORE;
          break;
 
@@ -196,8 +234,9 @@ private:
             auto buffer = (uint8_t*) &edit_patch;
             buffer[index] = byte;
 
+            activateEditPatch(/* update */ true);
             for(unsigned i = 0; i < N; ++i)
-               updateVoice(i, 0, /* update */ true);
+               this->voice[i].loadProgram(patch);
          }
          state = STATE_IGNORE;
          break;
@@ -215,62 +254,178 @@ private:
       }
    }
 
-   void updateVoice(unsigned index_, unsigned number_, bool update_)
+   //! Show a patch change recorded by the render path, the LCD and
+   //! console output are too slow for the audio callback
+   void updateDisplay() override
    {
-      if (index_ == 0)
-      {
-         // 7-seg LED output
-         this->setNumber(number_);
+      uint32_t show = show_patch.exchange(0, std::memory_order_acquire);
 
-         // 16x2 LCD output
-         char line[32];
-         if (number_ == 0)
-            strcpy(line, "edt             ");
-         else
-            snprintf(line, sizeof(line), "%03u             ", number_);
-         memcpy(line + 4, (const char*)edit_patch.name, 10);
-         this->setText(0, line);
-
-         snprintf(line, sizeof(line), "A%2u F%1u %c%c%c%c%c%c   ",
-                  edit_patch.alg + 1, edit_patch.feedback,
-                  edit_patch.op[5].osc_mode == SysEx::FIXED ? 'F' : 'R',
-                  edit_patch.op[4].osc_mode == SysEx::FIXED ? 'F' : 'R',
-                  edit_patch.op[3].osc_mode == SysEx::FIXED ? 'F' : 'R',
-                  edit_patch.op[2].osc_mode == SysEx::FIXED ? 'F' : 'R',
-                  edit_patch.op[1].osc_mode == SysEx::FIXED ? 'F' : 'R',
-                  edit_patch.op[0].osc_mode == SysEx::FIXED ? 'F' : 'R');
-         this->setText(1, line);
-
-         // Console output
-         if (not update_)
-         {
-            edit_patch.print(number_);
-         }
+      if ((show & SHOW_PENDING) != 0)
+         showPatch(show & SHOW_NUMBER, /* update */ (show & SHOW_PRINT) == 0);
+   }
+
+   //! Record a patch change for updateDisplay(), a print requested by an
+   //! earlier change that has not been shown yet is kept
+   void requestShow(unsigned number_, bool update_)
+   {
+      uint32_t print = update_ ? show_patch.load(std::memory_order_relaxed) & SHOW_PRINT
+                               : SHOW_PRINT;
+
+      show_patch.store(SHOW_PENDING | print | number_, std::memory_order_release);
+   }
+
+   //! Display the edit buffer
+   void showPatch(unsigned number_, bool update_)
+   {
+      // 7-seg LED output
+      this->setNumber(number_);
+
+      // 16x2 LCD output
+      char line[32];
+      if (number_ == 0)
+         strcpy(line, "edt             ");
+      else
+         snprintf(line, sizeof(line), "%03u             ", number_);
+      memcpy(line + 4, (const char*)edit_patch.name, 10);
+      this->setText(0, line);
+
+      snprintf(line, sizeof(line), "A%2u F%1u %c%c%c%c%c%c   ",
+               edit_patch.alg + 1, edit_patch.feedback,
+               edit_patch.op[5].osc_mode == SysEx::FIXED ? 'F' : 'R',
+               edit_patch.op[4].osc_mode == SysEx::FIXED ? 'F' : 'R',
+               edit_patch.op[3].osc_mode == SysEx::FIXED ? 'F' : 'R',
+               edit_patch.op[2].osc_mode == SysEx::FIXED ? 'F' : 'R',
+               edit_patch.op[1].osc_mode == SysEx::FIXED ? 'F' : 'R',
+               edit_patch.op[0].osc_mode == SysEx::FIXED ? 'F' : 'R');
+      this->setText(1, line);
+
+      // Console output
+      if (not update_)
+      {
+         edit_patch.print(number_);
       }
+   }
+
+   //! Activate the edit buffer after it has been modified, the activated
+   //! patch is shared by all voices so the cost does not depend on the
+   //! number of voices
+   void activateEditPatch(bool update_)
+   {
+      requestShow(0, update_);
 
-      this->voice[index_].loadProgram(&edit_patch);
+      patch.activate(edit_patch);
+      active_patch = &patch;
+      patch_number = 0;
    }
 
-   void voiceProgram(unsigned index_, uint8_t number_) override
+   void programEvent(unsigned index_, uint8_t number_) override
    {
       const SysEx::Packed* memory;
+      const uint8_t*       image;   // Patches activated at build time
 
       switch(number_ >> 5)
       {
-      case 0: memory = internal_patches;                       break;
-      case 1: memory = (const SysEx::Packed*) table_dx7_rom_2; break;
+      case 0:
+         memory = internal_patches;
+         image  = internal_is_rom ? table_dx7_patch_1 : nullptr;
+         break;
+
+      case 1: memory = (const SysEx::Packed*) table_dx7_rom_2; image = table_dx7_patch_2; break;
 
       // DX7 did not support selecting programs above 63
-      case 2: memory = (const SysEx::Packed*) table_dx7_rom_3; break;
-      case 3: memory = (const SysEx::Packed*) table_dx7_rom_4; break;
+      case 2: memory = (const SysEx::Packed*) table_dx7_rom_3; image = table_dx7_patch_3; break;
+      case 3: memory = (const SysEx::Packed*) table_dx7_rom_4; image = table_dx7_patch_4; break;
 
       default:
          return;
       }
 
-      edit_patch = memory[number_ & 0x1F];
+      // Only look up when the program changes, not for every voice
+      if ((number_ + 1u) != patch_number)
+      {
+         unsigned             program = number_ & 0x1F;
+         const SysEx::Packed& packed  = memory[program];
+
+         if (image != nullptr)
+            image += program * Patch::IMAGE_SIZE;
+
+         edit_patch   = packed;
+         active_patch = &patch_cache.find(number_, packed, image);
+         patch_number = number_ + 1;
+
+         requestShow(patch_number, /* update */ false);
+      }
+
+      this->voice[index_].loadProgram(*active_patch);
+   }
+
+   //! Saves a reference to a patch as its place in the synth, see
+   //! Firmware::snapshot()
+   struct PatchIds
+   {
+      static const uint8_t SILENT = 0;
+      static const uint8_t EDIT   = 1;
+      static const uint8_t CACHE  = 2;   //!< First patch cache entry
+
+      template <typename SNAPSHOT>
+      void field(SNAPSHOT& s_, const Patch*& patch_)
+      {
+         uint8_t id = patch_ == &Patch::silent() ? SILENT
+                    : patch_ == &synth.patch     ? EDIT
+                                                 : CACHE + synth.patch_cache.indexOf(patch_);
+         s_.field(id);
+
+         const Patch* patch = id == SILENT ? &Patch::silent()
+                            : id == EDIT   ? &synth.patch
+                                           : synth.patch_cache.getPatch(id - CACHE);
+         if (patch == nullptr)
+            s_.fail();
+         else
+            patch_ = patch;
+      }
+
+      Synth& synth;
+   };
 
-      updateVoice(index_, number_ + 1, /* update */ false);
+   //! Save or restore the complete state, see Snapshot. The patches are
+   //! restored before the voices that reference them
+   template <typename SNAPSHOT>
+   void snapshot(SNAPSHOT& s_)
+   {
+      PatchIds ids{*this};
+
+      s_.field(edit_patch);
+      s_.field(internal_is_rom);
+
+      if (internal_is_rom)
+         memcpy(internal_patches, table_dx7_rom_1, sizeof(internal_patches));
+      else
+         s_.field(internal_patches);
+
+      s_.field(patch);
+      patch_cache.snapshot(s_);
+      ids.field(s_, active_patch);
+      s_.field(patch_number);
+
+      s_.field(state);
+      s_.field(size);
+      s_.field(index);
+
+      SynthVoice<VOICE,N,AMP_N>::snapshot(s_, ids);
+   }
+
+   //! Identifies the snapshot version and the synth configuration
+   static uint32_t stateId()
+   {
+      static const uint32_t VERSION = 1;
+
+      const uint32_t layout[] =
+      {
+         VERSION, N, AMP_N, sizeof(VOICE), sizeof(Patch), sizeof(EnvGen),
+         sizeof(Lfo), sizeof(PitchEg<1>), sizeof(Modulation), sizeof(SysEx::Voice)
+      };
+
+      return Snapshot::hash((const uint8_t*)layout, sizeof(layout));
    }
 
    const uint8_t ID_YAMAHA              = 67;
@@ -287,6 +442,19 @@ private:
 
    SysEx::Voice  edit_patch;
    SysEx::Packed internal_patches[32];
+   bool          internal_is_rom{true};    //!< internal_patches still holds ROM 1
+   Patch         patch{};                  //!< Activated edit_patch after an edit
+   PatchCache<>  patch_cache{};            //!< Activated programs
+   const Patch*  active_patch{&patch};     //!< Patch played by the voices
+   unsigned      patch_number{NO_PATCH};   //!< Program in active_patch, 0 => edited
+
+   static const unsigned NO_PATCH = ~0u;
+
+   static const uint32_t SHOW_PENDING = 1u << 31;
+   static const uint32_t SHOW_PRINT   = 1u << 30;
+   static const uint32_t SHOW_NUMBER  = 0xFF;
+
+   std::atomic<uint32_t> show_patch{0};    //!< Patch change for updateDisplay()
 
    // SYSEX state machine state
    State  state{STATE_IGNORE};
@@ -294,4 +462,22 @@ private:
    size_t index{};
 };
 
+//! Synth with the per-sample state of all voices held together in a
+//! structure-of-arrays bank
+template <unsigned N, unsigned AMP_N = N>
+class BankSynth : public Synth<N, AMP_N, BankVoice>
+{
+public:
+   BankSynth()
+   {
+      for(unsigned i = 0; i < N; ++i)
+      {
+         this->voice[i].attach(bank, i);
+      }
+   }
+
+private:
+   DX::OpsBank<N, /* NUM_OP */ 6, EnvGen> bank;
+};
+
 } // namespace DX7
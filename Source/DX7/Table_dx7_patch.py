@@ -0,0 +1,259 @@
+#-------------------------------------------------------------------------------
+# Copyright (c) 2025 John D. Haughton
+# SPDX-License-Identifier: MIT
+#-------------------------------------------------------------------------------
+
+# Activated voice patches (see DX7::Patch) for a cartridge image so that
+# selecting a ROM program does not need a PATCH_ACTIVATE at run-time.
+# The activation must match Patch::activate() exactly, this is checked by
+# the unit test testPatchRom.cpp
+
+import sys
+import table
+
+# extract digit from this script name 'Table_dx7_patch_N.py'
+index    = sys.argv[0][-4]
+filename = sys.argv[1]
+
+image = []
+
+with open(filename, 'rb') as file:
+   while True:
+      byte = file.read(1)
+      if byte == b'':
+         break
+      image.append(int.from_bytes(byte, byteorder='big', signed=False))
+
+offset = 6
+
+# Layout of an activated patch, must match DX7::Patch::load()
+IMAGE_SIZE    = 512
+OP_SIZE       = 64
+OP_KBD_SCALE  = 18
+VOICE         = 6 * OP_SIZE
+NUM_PATCH     = 32
+PACKED_SIZE   = 128
+PACKED_OP     = 17
+
+table_log = [
+   0x7F, 0x7A, 0x76, 0x72, 0x6E, 0x6B, 0x68, 0x66, 0x64, 0x62,
+   0x60, 0x5E, 0x5C, 0x5A, 0x58, 0x56, 0x55, 0x54, 0x52, 0x51,
+   0x4F, 0x4E, 0x4D, 0x4C, 0x4B, 0x4A, 0x49, 0x48, 0x47, 0x46,
+   0x45, 0x44, 0x43, 0x42, 0x41, 0x40, 0x3F, 0x3E, 0x3D, 0x3C,
+   0x3B, 0x3A, 0x39, 0x38, 0x37, 0x36, 0x35, 0x34, 0x33, 0x32,
+   0x31, 0x30, 0x2F, 0x2E, 0x2D, 0x2C, 0x2B, 0x2A, 0x29, 0x28,
+   0x27, 0x26, 0x25, 0x24, 0x23, 0x22, 0x21, 0x20, 0x1F, 0x1E,
+   0x1D, 0x1C, 0x1B, 0x1A, 0x19, 0x18, 0x17, 0x16, 0x15, 0x14,
+   0x13, 0x12, 0x11, 0x10, 0x0F, 0x0E, 0x0D, 0x0C, 0x0B, 0x0A,
+   0x09, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00]
+
+table_key_pitch = [
+   0x00, 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08,
+   0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x10, 0x11, 0x12,
+   0x14, 0x15, 0x16, 0x18, 0x19, 0x1A, 0x1C, 0x1D,
+   0x1E, 0x20, 0x21, 0x22, 0x24, 0x25, 0x26, 0x28,
+   0x29, 0x2A, 0x2C, 0x2D, 0x2E, 0x30, 0x31, 0x32,
+   0x34, 0x35, 0x36, 0x38, 0x39, 0x3A, 0x3C, 0x3D,
+   0x3E, 0x40, 0x41, 0x42, 0x44, 0x45, 0x46, 0x48,
+   0x49, 0x4A, 0x4C, 0x4D, 0x4E, 0x50, 0x51, 0x52,
+   0x54, 0x55, 0x56, 0x58, 0x59, 0x5A, 0x5C, 0x5D,
+   0x5E, 0x60, 0x61, 0x62, 0x64, 0x65, 0x66, 0x68,
+   0x69, 0x6A, 0x6C, 0x6D, 0x6E, 0x70, 0x71, 0x72,
+   0x74, 0x75, 0x76, 0x78, 0x79, 0x7A, 0x7C, 0x7D,
+   0x7E, 0x80, 0x81, 0x82, 0x84, 0x85, 0x86, 0x88,
+   0x89, 0x8A, 0x8C, 0x8D, 0x8E, 0x90, 0x91, 0x92,
+   0x94, 0x95, 0x96, 0x98, 0x99, 0x9A, 0x9C, 0x9D,
+   0x9E, 0xA0, 0xA1, 0xA2, 0xA4, 0xA5, 0xA6, 0xA8]
+
+# Extended by the 3 bytes that follow each table in the ROM (see Patch.h)
+table_kbd_scaling_curve_exp = [
+   0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+   0x06, 0x07, 0x08, 0x09, 0x0B, 0x0E,
+   0x10, 0x13, 0x17, 0x1C, 0x21, 0x27,
+   0x2F, 0x39, 0x43, 0x50, 0x5F, 0x71,
+   0x86, 0xA0, 0xBE, 0xE0, 0xFF, 0xFF,
+   0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+   0x00, 0x08, 0x10]
+
+table_kbd_scaling_curve_lin = [
+   0x00, 0x08, 0x10, 0x18, 0x20, 0x28,
+   0x30, 0x38, 0x40, 0x48, 0x50, 0x58,
+   0x60, 0x68, 0x70, 0x78, 0x80, 0x88,
+   0x90, 0x98, 0xA0, 0xA8, 0xB2, 0xB8,
+   0xC0, 0xC8, 0xD0, 0xD8, 0xE0, 0xE8,
+   0xF0, 0xF8, 0xFF, 0xFF, 0xFF, 0xFF,
+   0x7F, 0x7A, 0x76]
+
+table_op_freq_coarse = [
+   0xF000, 0x0000, 0x1000, 0x195C, 0x2000, 0x2528, 0x295C, 0x2CEC,
+   0x3000, 0x32B8, 0x3528, 0x375A, 0x395C, 0x3B34, 0x3CEC, 0x3E84,
+   0x4000, 0x4168, 0x42B8, 0x43F8, 0x4528, 0x4648, 0x475A, 0x4860,
+   0x495C, 0x4A4C, 0x4B34, 0x4C14, 0x4CEC, 0x4DBA, 0x4E84, 0x4F44]
+
+table_op_freq_fine = [
+   0x000, 0x03A, 0x075, 0x0AE, 0x0E7, 0x120, 0x158, 0x18F, 0x1C6, 0x1FD,
+   0x233, 0x268, 0x29D, 0x2D2, 0x306, 0x339, 0x36D, 0x39F, 0x3D2, 0x403,
+   0x435, 0x466, 0x497, 0x4C7, 0x4F7, 0x526, 0x555, 0x584, 0x5B2, 0x5E0,
+   0x60E, 0x63B, 0x668, 0x695, 0x6C1, 0x6ED, 0x719, 0x744, 0x76F, 0x799,
+   0x7C4, 0x7EE, 0x818, 0x841, 0x86A, 0x893, 0x8BC, 0x8E4, 0x90C, 0x934,
+   0x95C, 0x983, 0x9AA, 0x9D1, 0x9F7, 0xA1D, 0xA43, 0xA69, 0xA8F, 0xAB4,
+   0xAD9, 0xAFE, 0xB22, 0xB47, 0xB6B, 0xB8F, 0xBB2, 0xBD6, 0xBF9, 0xC1C,
+   0xC3F, 0xC62, 0xC84, 0xCA7, 0xCC9, 0xCEA, 0xD0C, 0xD2E, 0xD4F, 0xD70,
+   0xD91, 0xDB2, 0xDD2, 0xDF3, 0xE13, 0xE33, 0xE53, 0xE72, 0xE92, 0xEB1,
+   0xED0, 0xEEF, 0xF0E, 0xF2D, 0xF4C, 0xF6A, 0xF88, 0xFA6, 0xFC4, 0xFE2]
+
+table_op_freq_fixed = [0x0000, 0x3526, 0x6A4C, 0x9F74]
+
+table_pitch_eg_rate = [
+   0x01, 0x02, 0x03, 0x03, 0x04, 0x04, 0x05, 0x05, 0x06, 0x06,
+   0x07, 0x07, 0x08, 0x08, 0x09, 0x09, 0x0A, 0x0A, 0x0B, 0x0B,
+   0x0C, 0x0C, 0x0D, 0x0D, 0x0E, 0x0E, 0x0F, 0x10, 0x10, 0x11,
+   0x12, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A,
+   0x1B, 0x1C, 0x1E, 0x1F, 0x21, 0x22, 0x24, 0x25, 0x26, 0x27,
+   0x29, 0x2A, 0x2C, 0x2E, 0x2F, 0x31, 0x33, 0x35, 0x36, 0x38,
+   0x3A, 0x3C, 0x3E, 0x40, 0x42, 0x44, 0x46, 0x48, 0x4A, 0x4C,
+   0x4F, 0x52, 0x55, 0x58, 0x5B, 0x5E, 0x62, 0x66, 0x6A, 0x6E,
+   0x73, 0x78, 0x7D, 0x82, 0x87, 0x8D, 0x93, 0x99, 0x9F, 0xA5,
+   0xAB, 0xB2, 0xB9, 0xC1, 0xCA, 0xD3, 0xE8, 0xF3, 0xFE, 0xFF]
+
+table_pitch_eg_level = [
+   0x00, 0x0C, 0x18, 0x21, 0x2B, 0x34, 0x3C, 0x43, 0x48, 0x4C,
+   0x4F, 0x52, 0x55, 0x57, 0x59, 0x5B, 0x5D, 0x5F, 0x60, 0x61,
+   0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x6B,
+   0x6C, 0x6D, 0x6E, 0x6F, 0x70, 0x71, 0x72, 0x73, 0x74, 0x75,
+   0x76, 0x77, 0x78, 0x79, 0x7A, 0x7B, 0x7C, 0x7D, 0x7E, 0x7F,
+   0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+   0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F, 0x90, 0x91, 0x92, 0x93,
+   0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0x9B, 0x9C, 0x9D,
+   0x9E, 0x9F, 0xA0, 0xA1, 0xA2, 0xA3, 0xA6, 0xA8, 0xAB, 0xAE,
+   0xB1, 0xB5, 0xBA, 0xC1, 0xC9, 0xD2, 0xDC, 0xE7, 0xF3, 0xFF]
+
+table_pitch_mod_sense = [0, 10, 20, 33, 55, 92, 153, 255]
+
+
+def put16(out, i, value):
+   out[i + 0] = value & 0xFF
+   out[i + 1] = (value >> 8) & 0xFF
+
+
+def kbdScaling(packed):
+   """ PATCH_ACTIVATE_OPERATOR_KBD_SCALING """
+   breakpoint  = table_key_pitch[packed[8] + 20] >> 2
+   depth_left  = (packed[9] * 660) >> 8
+   depth_right = (packed[10] * 660) >> 8
+
+   lft_curve = packed[11] & 0b11
+   rgt_curve = (packed[11] >> 2) & 0b11
+
+   left_sign  = -1 if lft_curve >= 2 else +1
+   left_lin   = lft_curve == 0 or lft_curve == 3
+   left       = table_kbd_scaling_curve_lin if left_lin else table_kbd_scaling_curve_exp
+
+   right_sign = -1 if rgt_curve >= 2 else +1
+   right_lin  = rgt_curve == 0 or rgt_curve == 3
+   right      = table_kbd_scaling_curve_lin if right_lin else table_kbd_scaling_curve_exp
+
+   out_level = table_log[packed[14]]
+
+   scaling = []
+
+   for note in range(1, 44):
+      offset = note - breakpoint
+
+      if offset <= 0:
+         curve = left[-offset] * depth_left * left_sign
+      else:
+         curve = right[offset] * depth_right * right_sign
+
+      note_level = (out_level + (curve >> 8)) << 1
+      scaling.append(min(max(note_level, 0), 0xFF))
+
+   return scaling
+
+
+def activateOp(out, base, packed, enable):
+   for i in range(4):
+      out[base + i]     = (packed[i] * 164) >> 8                    # PATCH_ACTIVATE_OPERATOR_EG_RATE
+      out[base + 4 + i] = table_log[min(packed[4 + i], 99)] >> 1   # PATCH_ACTIVATE_OPERATOR_EG_LEVEL
+
+   # PATCH_ACTIVATE_OPERATOR_PITCH
+   osc_mode = packed[15] & 1
+   coarse   = (packed[15] >> 1) & 0b11111
+   fine     = packed[16]
+
+   if osc_mode == 0:
+      ratio = table_op_freq_coarse[coarse] + table_op_freq_fine[fine] + 0x232C
+   else:
+      ratio = table_op_freq_fixed[coarse & 0b11] + fine * 136 + 0x16AC
+
+   put16(out, base + 8, ratio & 0xFFFF)
+   out[base + 10] = osc_mode
+
+   # PATCH_ACTIVATE_OPERATOR_DETUNE
+   out[base + 11] = (((packed[12] >> 3) & 0b1111) - 7) & 0xFF
+
+   # PATCH_ACTIVATE_OPERATOR_KBD_RATE_SCALING
+   out[base + 12] = packed[12] & 0b111
+   out[base + 13] = packed[13] & 0b11
+   out[base + 14] = enable
+
+   # PATCH_ACTIVATE_OPERATOR_VEL_SENS
+   put16(out, base + 16, (8 - ((packed[13] >> 2) & 0b111)) * 0x1E0)
+
+   out[base + OP_KBD_SCALE : base + OP_KBD_SCALE + 43] = kbdScaling(packed)
+
+
+def activate(packed):
+   out = [0] * IMAGE_SIZE
+
+   for op in range(6):
+      activateOp(out, op * OP_SIZE, packed[op * PACKED_OP : (op + 1) * PACKED_OP], 1)
+
+   eg_pitch = packed[102 : 110]
+   lfo      = packed[112 : 118]
+
+   # PATCH_ACTIVATE_ALG_MODE
+   out[VOICE + 0] = packed[110]
+   out[VOICE + 1] = packed[111] & 0b111
+   out[VOICE + 2] = (packed[111] >> 3) & 1
+   out[VOICE + 3] = packed[117]
+
+   # LFO
+   speed = (lfo[0] * 660) >> 8
+   scale = 11
+   if speed == 0:
+      speed = 1
+   elif speed >= 160:
+      scale += (speed - 160) >> 2
+   put16(out, VOICE + 4, (scale * speed) & 0xFFFF)
+
+   delay   = 99 - lfo[1]
+   exp     = 7 - (delay >> 4)
+   mantisa = ((0b10000 | (delay & 0b1111)) << 9) & 0xFFFF
+   put16(out, VOICE + 6, mantisa >> exp)
+
+   out[VOICE + 8]  = (lfo[4] >> 1) & 0b111                      # waveform
+   out[VOICE + 9]  = (lfo[3] * 660) >> 8                        # amp_mod_depth
+   out[VOICE + 10] = (lfo[2] * 660) >> 8                        # pitch_mod_depth
+   out[VOICE + 11] = table_pitch_mod_sense[(lfo[4] >> 4) & 0b111]
+   out[VOICE + 12] = lfo[4] & 1                                 # sync
+
+   # Pitch EG
+   for i in range(4):
+      out[VOICE + 16 + i] = table_pitch_eg_rate[eg_pitch[i]]
+      out[VOICE + 20 + i] = table_pitch_eg_level[eg_pitch[4 + i]]
+
+   return out
+
+
+patches = []
+
+for n in range(NUM_PATCH):
+   start = offset + n * PACKED_SIZE
+   patches += activate(image[start : start + PACKED_SIZE])
+
+table.gen("dx7_patch_" + index,
+          func      = lambda i,x : patches[i],
+          typename  = "uint8_t",
+          log2_size = 14,
+          fmt       = '02x')
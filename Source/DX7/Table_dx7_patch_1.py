@@ -0,0 +1 @@
+Table_dx7_patch.py
\ No newline at end of file
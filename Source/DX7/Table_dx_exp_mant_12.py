@@ -0,0 +1,25 @@
+#-------------------------------------------------------------------------------
+# Copyright (c) 2025 John D. Haughton
+# SPDX-License-Identifier: MIT
+#-------------------------------------------------------------------------------
+
+import math
+import table
+
+def dx_exp_mant_12(index_10, x):
+   """ 10-bit => 12-bit 2^x mantissa, the compact form of dx_exp_14 and dx_exp_32
+
+       dx_exp_14[i] == (mant[~i & 0x3FF] << ((~i & 0x3FFF) >> 10)) >> 13
+       dx_exp_32[i] is (mant[i & 0x3FF] << (i >> 10)) >> 5 re-scaled to 32 bits """
+   exp = index_10 / 1024
+
+# NOTE: The rounding matches the values compressed into the actual ROM as used
+#       for the full dx_exp_14 and dx_exp_32 tables
+   return int(math.pow(2.0, exp) * 0x800 + 0.5)
+
+table.gen('dx_exp_mant_12',
+          func      = dx_exp_mant_12,
+          typename  = "uint16_t",
+          log2_size = 10,
+          fmt       = '04x',
+          is_const  = False)
@@ -0,0 +1,20 @@
+#-------------------------------------------------------------------------------
+# Copyright (c) 2025 John D. Haughton
+# SPDX-License-Identifier: MIT
+#-------------------------------------------------------------------------------
+
+import math
+import table
+
+def dx_log_sine_quarter_14(index_10, x):
+   """ 10-bit => 14-bit abs-log-sine for the first quarter wave, the compact form
+       of dx_log_sine_14 which mirrors this in the other three quarters """
+   phase = ((index_10 + 0.5) * math.pi) / 2048
+   return int(-math.log(abs(math.sin(phase)), 2) * 1024 + 0.5002)
+
+table.gen('dx_log_sine_quarter_14',
+          func      = dx_log_sine_quarter_14,
+          typename  = "uint16_t",
+          log2_size = 10,
+          fmt       = '04x',
+          is_const  = False)
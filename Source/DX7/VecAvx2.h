@@ -0,0 +1,73 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief 8 x 32-bit integer lanes using AVX2
+
+#pragma once
+
+#include <cstdint>
+
+#include <immintrin.h>
+
+namespace DX {
+
+//! 8 x 32-bit integer lanes using AVX2
+class VecAvx2
+{
+public:
+   static const unsigned LANES = 8;
+
+   VecAvx2() = default;
+
+   VecAvx2(__m256i v_) : v(v_) {}
+
+   static VecAvx2 splat(int32_t value_) { return _mm256_set1_epi32(value_); }
+
+   static VecAvx2 load(const uint32_t* ptr_) { return _mm256_loadu_si256((const __m256i*)ptr_); }
+   static VecAvx2 load(const int32_t* ptr_)  { return _mm256_loadu_si256((const __m256i*)ptr_); }
+
+   void store(uint32_t* ptr_) const { _mm256_storeu_si256((__m256i*)ptr_, v); }
+   void store(int32_t* ptr_)  const { _mm256_storeu_si256((__m256i*)ptr_, v); }
+
+   friend VecAvx2 operator+(VecAvx2 a_, VecAvx2 b_) { return _mm256_add_epi32(a_.v, b_.v); }
+   friend VecAvx2 operator-(VecAvx2 a_, VecAvx2 b_) { return _mm256_sub_epi32(a_.v, b_.v); }
+   friend VecAvx2 operator^(VecAvx2 a_, VecAvx2 b_) { return _mm256_xor_si256(a_.v, b_.v); }
+
+   template <unsigned N> VecAvx2 sll() const { return _mm256_slli_epi32(v, N); }
+   template <unsigned N> VecAvx2 srl() const { return _mm256_srli_epi32(v, N); }
+   template <unsigned N> VecAvx2 sra() const { return _mm256_srai_epi32(v, N); }
+
+   //! Arithmetic shift right by a per-lane amount
+   VecAvx2 sra(VecAvx2 shift_) const { return _mm256_srav_epi32(v, shift_.v); }
+
+   static VecAvx2 min(VecAvx2 a_, VecAvx2 b_) { return _mm256_min_epi32(a_.v, b_.v); }
+
+   //! Per-lane lookup in a 16-bit table of SIZE entries
+   //! The gather reads 32-bits so the last entry is fetched as the upper half
+   //! of the preceeding pair to avoid reading beyond the end of the table
+   template <unsigned SIZE>
+   static VecAvx2 gather(const uint16_t* table_, VecAvx2 index_)
+   {
+      __m256i safe  = _mm256_min_epi32(index_.v, _mm256_set1_epi32(SIZE - 2));
+      __m256i pair  = _mm256_i32gather_epi32((const int*)table_, safe, 2);
+      __m256i shift = _mm256_slli_epi32(_mm256_sub_epi32(index_.v, safe), 4);
+
+      return _mm256_and_si256(_mm256_srlv_epi32(pair, shift), _mm256_set1_epi32(0xFFFF));
+   }
+
+   //! Sum of all lanes
+   int32_t hsum() const
+   {
+      __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+      sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+      sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+      return _mm_cvtsi128_si32(sum);
+   }
+
+private:
+   __m256i v;
+};
+
+} // namespace DX
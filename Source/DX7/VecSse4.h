@@ -0,0 +1,81 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief 4 x 32-bit integer lanes using SSE4.1
+
+#pragma once
+
+#include <cstdint>
+
+#include <smmintrin.h>
+
+namespace DX {
+
+//! 4 x 32-bit integer lanes using SSE4.1
+class VecSse4
+{
+public:
+   static const unsigned LANES = 4;
+
+   VecSse4() = default;
+
+   VecSse4(__m128i v_) : v(v_) {}
+
+   static VecSse4 splat(int32_t value_) { return _mm_set1_epi32(value_); }
+
+   static VecSse4 load(const uint32_t* ptr_) { return _mm_loadu_si128((const __m128i*)ptr_); }
+   static VecSse4 load(const int32_t* ptr_)  { return _mm_loadu_si128((const __m128i*)ptr_); }
+
+   void store(uint32_t* ptr_) const { _mm_storeu_si128((__m128i*)ptr_, v); }
+   void store(int32_t* ptr_)  const { _mm_storeu_si128((__m128i*)ptr_, v); }
+
+   friend VecSse4 operator+(VecSse4 a_, VecSse4 b_) { return _mm_add_epi32(a_.v, b_.v); }
+   friend VecSse4 operator-(VecSse4 a_, VecSse4 b_) { return _mm_sub_epi32(a_.v, b_.v); }
+   friend VecSse4 operator^(VecSse4 a_, VecSse4 b_) { return _mm_xor_si128(a_.v, b_.v); }
+
+   template <unsigned N> VecSse4 sll() const { return _mm_slli_epi32(v, N); }
+   template <unsigned N> VecSse4 srl() const { return _mm_srli_epi32(v, N); }
+   template <unsigned N> VecSse4 sra() const { return _mm_srai_epi32(v, N); }
+
+   //! Arithmetic shift right by a per-lane amount (no SSE instruction for this)
+   VecSse4 sra(VecSse4 shift_) const
+   {
+      alignas(16) int32_t value[LANES];
+      alignas(16) int32_t shift[LANES];
+
+      _mm_store_si128((__m128i*)value, v);
+      _mm_store_si128((__m128i*)shift, shift_.v);
+
+      for(unsigned i = 0; i < LANES; ++i)
+         value[i] >>= shift[i];
+
+      return _mm_load_si128((const __m128i*)value);
+   }
+
+   static VecSse4 min(VecSse4 a_, VecSse4 b_) { return _mm_min_epi32(a_.v, b_.v); }
+
+   //! Per-lane lookup in a 16-bit table of SIZE entries (no SSE gather instruction)
+   template <unsigned SIZE>
+   static VecSse4 gather(const uint16_t* table_, VecSse4 index_)
+   {
+      return _mm_setr_epi32(table_[_mm_extract_epi32(index_.v, 0)],
+                            table_[_mm_extract_epi32(index_.v, 1)],
+                            table_[_mm_extract_epi32(index_.v, 2)],
+                            table_[_mm_extract_epi32(index_.v, 3)]);
+   }
+
+   //! Sum of all lanes
+   int32_t hsum() const
+   {
+      __m128i sum = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+      sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+      return _mm_cvtsi128_si32(sum);
+   }
+
+private:
+   __m128i v;
+};
+
+} // namespace DX
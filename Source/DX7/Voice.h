@@ -7,77 +7,151 @@
 
 #include "VoiceBase.h"
 
+#include "Channel.h"
 #include "Firmware.h"
+#include "Patch.h"
 #include "SysEx.h"
 #include "Egs.h"
+#include "OpsSimd.h"
+#include "OpsBank.h"
 
 namespace DX7 {
 
-class Voice : public VoiceBase
+//! EGS is the hardware model, which determines where per-sample state is held
+template <typename EGS = Egs<>>
+class Voice : public VoiceBase<Voice<EGS>>
 {
+   friend VoiceBase<Voice>;
+
 public:
+   using Channel = DX7::Channel;
+
    Voice() = default;
 
-   void loadProgram(const SysEx::Voice* voice)
+   //! Relocate per-sample state into a bank
+   template <typename BANK>
+   void attach(BANK& bank_, unsigned index_)
+   {
+      bank_.attach(hw.getState(), index_);
+      hw.bindOps();
+   }
+
+   //! Operator evaluation counters
+   const OpsStats& getOpsStats() { return hw.getStats(); }
+
+   //! Play an activated patch, shared with other voices
+   void loadProgram(const Patch& patch_)
+   {
+      fw.loadVoice(patch_);
+   }
+
+   //! Follow the controllers of a channel, shared with other voices
+   void setChannel(const Channel& channel_)
    {
-      fw.loadVoice(voice);
+      fw.loadChannel(channel_);
+   }
+
+   //! Save or restore the voice state, see Snapshot. patches_ saves the
+   //! reference to the patch, see Firmware::snapshot()
+   template <typename SNAPSHOT, typename PATCHES>
+   void snapshot(SNAPSHOT& s_, PATCHES& patches_)
+   {
+      VoiceBase<Voice>::snapshot(s_);
+
+      hw.snapshot(s_);
+      fw.snapshot(s_, patches_);
    }
 
    void tick()
    {
       if (hw.isComplete())
       {
-         mute();
+         this->mute();
       }
 
       fw.tick();
    }
 
+   //! Cost of stealing this voice for a new note, a muted voice is free,
+   //! a released voice costs its carrier level and a held voice costs
+   //! more than any released voice
+   uint32_t getStealCost() const
+   {
+      if (this->isMute())
+         return 0;
+
+      uint32_t level = 0x1000 - hw.getCarrierAtten12();
+
+      return this->isOn() ? 0x1000 + level : level;
+   }
+
+   //! Estimated cost of rendering this voice, relative to other voices.
+   //! Derived from the operator count rather than timed, so the weights
+   //! do not depend on the machine they were measured on. Every operator
+   //! steps its phase and EG each sample and audible operators also do
+   //! the sine and exp table lookups, one unit is counted for each
+   uint32_t getRenderCost() const
+   {
+      if (this->isMute())
+         return 0;
+
+      return SysEx::NUM_OP + hw.getAudibleOps();
+   }
+
    //! Return next sample for this voice
    int32_t operator()()
    {
       return hw();
    }
 
-private:
-   //! Start a new note
-   void gateOn() override
+   //! Mix the next n samples for this voice into a buffer
+   void render(int32_t* out_, unsigned n_)
    {
-      fw.voiceAdd(note, level);
+      hw.render(out_, n_);
    }
 
-   //! Release a new note
-   void gateOff() override
+   //! Advance the next n samples for this voice without rendering them
+   void skip(unsigned n_)
    {
-      fw.voiceRemove();
+      hw.skip(n_);
    }
 
-   void updatePitch() override
+   //! Mix the next n samples for a set of voices into a buffer
+   static void render(Voice* const voice_[], unsigned count_, int32_t* out_, unsigned n_)
    {
-      fw.setPitchBend(pitch);
+      DX::OpsSimd::render(voice_, count_, out_, n_,
+                          [](Voice* v) -> EGS& { return v->hw; });
    }
 
-   void updateLevel() override
+   //! Advance the next n samples for a set of voices without rendering them
+   static void skip(Voice* const voice_[], unsigned count_, unsigned n_)
    {
-      fw.setModAfterTouch(level);
+      EGS::skip(voice_, count_, n_,
+                [](Voice* v) -> EGS& { return v->hw; });
    }
 
-   void updateControl(uint8_t number_, uint8_t value_) override
+private:
+   //! Start a new note
+   void gateOn()
    {
-      switch (number_)
-      {
-      case  1: fw.setModWheel(value_);         break;
-      case  2: fw.setModBreathControl(value_); break;
-      case  4: fw.setModFootControl(value_);   break;
+      fw.voiceAdd(this->note, this->level);
+   }
 
-      case 64: /* sustain */ break;
-      case 65: /* portamento */ break;
-      }
+   //! Release a new note
+   void gateOff()
+   {
+      fw.voiceRemove();
    }
 
 private:
-   Egs      hw;
-   Firmware fw{hw};
+   EGS           hw;
+   Firmware<EGS> fw{hw};
 };
 
+//! Voice with per-sample state held in a DX::OpsBank
+using BankVoice = Voice<Egs<DX::OpsBanked>>;
+
+//! Voice using the compact form of the OPS lookup tables
+using CompactVoice = Voice<Egs<DX::OpsCompact>>;
+
 } // namespace DX7
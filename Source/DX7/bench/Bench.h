@@ -0,0 +1,96 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief Helpers for host benchmarks
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Bench {
+
+//! Wall clock time (seconds)
+inline double now()
+{
+   using Clock = std::chrono::steady_clock;
+
+   return std::chrono::duration<double>(Clock::now().time_since_epoch()).count();
+}
+
+//! Count hardware cache misses for the calling thread
+//! Only available on Linux where the kernel allows access to hardware
+//! performance counters
+class CacheMisses
+{
+public:
+   CacheMisses()
+   {
+#if defined(__linux__)
+      perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+
+      attr.size           = sizeof(attr);
+      attr.type           = PERF_TYPE_HARDWARE;
+      attr.config         = PERF_COUNT_HW_CACHE_MISSES;
+      attr.disabled       = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv     = 1;
+
+      fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+   }
+
+   ~CacheMisses()
+   {
+#if defined(__linux__)
+      if (isAvailable())
+         close(fd);
+#endif
+   }
+
+   bool isAvailable() const { return fd >= 0; }
+
+   void start()
+   {
+#if defined(__linux__)
+      if (isAvailable())
+      {
+         ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+         ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+#endif
+   }
+
+   uint64_t stop()
+   {
+      uint64_t count = 0;
+
+#if defined(__linux__)
+      if (isAvailable())
+      {
+         ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+         if (read(fd, &count, sizeof(count)) != sizeof(count))
+            count = 0;
+      }
+#endif
+
+      return count;
+   }
+
+private:
+   int fd{-1};
+};
+
+} // namespace Bench
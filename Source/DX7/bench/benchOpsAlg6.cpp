@@ -0,0 +1,103 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief Render throughput of the scalar OPS for each of the 32 algorithms
+
+#include <cstdio>
+
+#include "DX7/OpsAlg6.h"
+
+#include "Bench.h"
+
+static const unsigned BLOCK      = 130;  //!< Samples per block
+static const unsigned NUM_BLOCKS = 4000; //!< Blocks per run
+static const unsigned NUM_REPEAT = 7;    //!< Best of N runs reported
+
+//! EG that sweeps repeatedly over the whole attenuation range
+class SweepEG
+{
+public:
+   SweepEG() = default;
+
+   void setStep(uint32_t step_) { step = step_; }
+
+   uint32_t getAtten12()
+   {
+      atten16 += step;
+      return atten16 >> 4;
+   }
+
+   uint32_t getMinAtten12(unsigned) const { return 0; }
+
+   void skip(unsigned n_) { atten16 += step * n_; }
+
+private:
+   uint16_t atten16{0};
+   uint32_t step{1};
+};
+
+static double run(uint8_t alg_)
+{
+   DX::OpsAlg6<SweepEG> ops{};
+
+   ops.setOpsAlg(alg_);
+   ops.setOpsFdbk(7);
+   ops.setOpsSync(true);
+
+   for(unsigned i = 0; i < 6; ++i)
+   {
+      ops.setOpsFreq(i, 0x1000 + i * 0x2A3);
+      ops.getEgPointer(i)->setStep(1 + i * 3);
+   }
+
+   ops.keyOn();
+
+   int32_t buffer[BLOCK] = {};
+
+   double start = Bench::now();
+
+   for(unsigned block = 0; block < NUM_BLOCKS; ++block)
+   {
+      ops.render(buffer, BLOCK);
+   }
+
+   double seconds = Bench::now() - start;
+
+   // Keep the result live
+   if (buffer[0] == 0x7FFFFFFF)
+      printf(" ");
+
+   return seconds;
+}
+
+int main()
+{
+   printf("alg   ns/sample\n");
+
+   double total = 0.0;
+
+   for(uint8_t alg = 0; alg < 32; ++alg)
+   {
+      double best = 0.0;
+
+      for(unsigned i = 0; i < NUM_REPEAT; ++i)
+      {
+         double seconds = run(alg);
+
+         if ((i == 0) || (seconds < best))
+            best = seconds;
+      }
+
+      double ns = best * 1e9 / (BLOCK * NUM_BLOCKS);
+
+      printf("%3u   %7.2f\n", alg + 1, ns);
+
+      total += ns;
+   }
+
+   printf("avg   %7.2f\n", total / 32);
+
+   return 0;
+}
@@ -0,0 +1,139 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief Compare rendering with per-sample state held in each voice against
+//        state held in a structure-of-arrays DX::OpsBank
+
+#include <cstdio>
+#include <initializer_list>
+
+#include "DX7/Voice.h"
+#include "DX7/OpsBank.h"
+
+#include "Table_dx7_rom_1.h"
+
+#include "Bench.h"
+
+static const unsigned SAMPLES_PER_TICK = 130;     //!< 49096 Hz / 375 Hz
+static const unsigned NUM_TICKS        = 375 * 2; //!< 2 seconds of audio
+static const unsigned NUM_REPEAT       = 7;       //!< Best of N runs reported
+
+struct Result
+{
+   double   seconds;
+   uint64_t misses;
+};
+
+template <typename VOICE, unsigned N>
+static Result run(VOICE (&voice_)[N])
+{
+   static DX7::Patch patch[32];
+
+   VOICE* active[N];
+
+   for(unsigned v = 0; v < N; ++v)
+   {
+      patch[v % 32].activate(SysEx::Voice{table_dx7_rom_1, v % 32});
+
+      voice_[v].loadProgram(patch[v % 32]);
+
+      active[v] = &voice_[v];
+   }
+
+   Bench::CacheMisses misses;
+   Result             result{};
+
+   double start = Bench::now();
+   misses.start();
+
+   for(unsigned tick = 0; tick < NUM_TICKS; ++tick)
+   {
+      if ((tick % 375) == 0)
+      {
+         for(unsigned v = 0; v < N; ++v)
+            voice_[v].noteOn(24 + (v * 7) % 72, 100);
+      }
+
+      int32_t buffer[SAMPLES_PER_TICK] = {};
+
+      VOICE::render(active, N, buffer, SAMPLES_PER_TICK);
+
+      for(unsigned v = 0; v < N; ++v)
+         voice_[v].tick();
+
+   }
+
+   result.misses  = misses.stop();
+   result.seconds = Bench::now() - start;
+
+   return result;
+}
+
+static void report(unsigned num_voices_, const char* layout_, const Result& result_)
+{
+   double audio_seconds = double(NUM_TICKS) / 375;
+
+   printf("%3u  %-6s  %-6s  %7.3f s  %6.1fx real-time",
+          num_voices_, DX::OpsSimd::getIsa() == DX::OpsSimd::SCALAR ? "scalar" : "simd",
+          layout_, result_.seconds, audio_seconds / result_.seconds);
+
+   if (result_.misses != 0)
+      printf("  %10llu cache misses", (unsigned long long)result_.misses);
+
+   printf("\n");
+}
+
+template <unsigned N>
+static void bench()
+{
+   // Value initialised so that both sets of voices start from the same state
+   static DX7::Voice<>   voice[N]{};
+   static DX7::BankVoice bank_voice[N]{};
+   static DX::OpsBank<N, /* NUM_OP */ 6, EnvGen> bank;
+
+   for(unsigned v = 0; v < N; ++v)
+      bank_voice[v].attach(bank, v);
+
+   // Alternate between the layouts to reduce the effect of any drift in
+   // the host performance and report the best of several runs
+   Result voice_best{};
+   Result bank_best{};
+
+   for(unsigned i = 0; i < NUM_REPEAT; ++i)
+   {
+      Result voice_result = run(voice);
+      Result bank_result  = run(bank_voice);
+
+      if ((i == 0) || (voice_result.seconds < voice_best.seconds))
+         voice_best = voice_result;
+
+      if ((i == 0) || (bank_result.seconds < bank_best.seconds))
+         bank_best = bank_result;
+   }
+
+   report(N, "voice", voice_best);
+   report(N, "bank",  bank_best);
+}
+
+int main()
+{
+   if (not Bench::CacheMisses().isAvailable())
+      printf("NOTE: hardware cache miss counters are not available\n");
+
+   printf("Voice %u bytes, per-sample state in bank %u bytes per voice\n",
+          unsigned(sizeof(DX7::Voice<>)),
+          unsigned(DX::OpsBank<128, 6, EnvGen>::hotSize() / 128));
+
+   for(DX::OpsSimd::Isa isa : {DX::OpsSimd::SCALAR, DX::OpsSimd::detect()})
+   {
+      DX::OpsSimd::setIsa(isa);
+
+      bench<32>();
+      bench<64>();
+      bench<128>();
+   }
+
+   return 0;
+}
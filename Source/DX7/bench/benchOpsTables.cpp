@@ -0,0 +1,108 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief Compare rendering with the full size OPS lookup tables against the
+//        compact form
+
+#include <cstdio>
+
+#include "DX7/Voice.h"
+
+#include "Table_dx7_rom_1.h"
+
+#include "Bench.h"
+
+static const unsigned SAMPLES_PER_TICK = 130;     //!< 49096 Hz / 375 Hz
+static const unsigned NUM_TICKS        = 375 * 2; //!< 2 seconds of audio
+static const unsigned NUM_REPEAT       = 7;       //!< Best of N runs reported
+
+template <typename VOICE, unsigned N>
+static double run(VOICE (&voice_)[N])
+{
+   static DX7::Patch patch[32];
+
+   VOICE* active[N];
+
+   for(unsigned v = 0; v < N; ++v)
+   {
+      patch[v % 32].activate(SysEx::Voice{table_dx7_rom_1, v % 32});
+
+      voice_[v].loadProgram(patch[v % 32]);
+
+      active[v] = &voice_[v];
+   }
+
+   double start = Bench::now();
+
+   for(unsigned tick = 0; tick < NUM_TICKS; ++tick)
+   {
+      if ((tick % 375) == 0)
+      {
+         for(unsigned v = 0; v < N; ++v)
+            voice_[v].noteOn(24 + (v * 7) % 72, 100);
+      }
+
+      int32_t buffer[SAMPLES_PER_TICK] = {};
+
+      VOICE::render(active, N, buffer, SAMPLES_PER_TICK);
+
+      for(unsigned v = 0; v < N; ++v)
+         voice_[v].tick();
+   }
+
+   return Bench::now() - start;
+}
+
+static void report(unsigned num_voices_, const char* tables_, double seconds_)
+{
+   double audio_seconds = double(NUM_TICKS) / 375;
+
+   printf("%3u  %-7s  %7.3f s  %6.1fx real-time\n",
+          num_voices_, tables_, seconds_, audio_seconds / seconds_);
+}
+
+template <unsigned N>
+static void bench()
+{
+   static DX7::Voice<>      voice[N]{};
+   static DX7::CompactVoice compact_voice[N]{};
+
+   // Alternate between the tables to reduce the effect of any drift in
+   // the host performance and report the best of several runs
+   double full_best    = 0.0;
+   double compact_best = 0.0;
+
+   for(unsigned i = 0; i < NUM_REPEAT; ++i)
+   {
+      double full    = run(voice);
+      double compact = run(compact_voice);
+
+      if ((i == 0) || (full < full_best))
+         full_best = full;
+
+      if ((i == 0) || (compact < compact_best))
+         compact_best = compact;
+   }
+
+   report(N, "full",    full_best);
+   report(N, "compact", compact_best);
+}
+
+int main()
+{
+   printf("Tables full %u bytes, compact %u bytes\n",
+          unsigned(sizeof(table_dx_exp_32) + sizeof(table_dx_exp_14) + sizeof(table_dx_log_sine_14)),
+          unsigned(sizeof(table_dx_exp_mant_12) + sizeof(table_dx_log_sine_quarter_14)));
+
+   // The SIMD kernels gather from the full tables so only the scalar
+   // OPS is compared
+   DX::OpsSimd::setIsa(DX::OpsSimd::SCALAR);
+
+   bench<1>();
+   bench<16>();
+   bench<64>();
+
+   return 0;
+}
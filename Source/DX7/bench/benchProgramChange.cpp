@@ -0,0 +1,116 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief Host benchmark for the latency of a program change
+
+#include <cstdio>
+
+#include "DX7/Voice.h"
+#include "DX7/PatchCache.h"
+
+#include "Table_dx7_rom_2.h"
+#include "Table_dx7_patch_2.h"
+
+#include "Bench.h"
+
+static const unsigned NUM_VOICES = 16;
+static const unsigned NUM_CHANGE = 20000;
+static const unsigned NUM_REPEAT = 7;       //!< Best of N runs reported
+static const double   TICK       = 1.0 / 375; //!< Firmware control tick (s)
+
+static const SysEx::Packed* rom = (const SysEx::Packed*)table_dx7_rom_2;
+
+static DX7::Voice<> voice[NUM_VOICES]{};
+
+//! Patch activated by every voice, as before patches were shared
+static void changePerVoice(unsigned number_)
+{
+   static DX7::Patch patch[NUM_VOICES];
+
+   for(unsigned v = 0; v < NUM_VOICES; ++v)
+   {
+      SysEx::Voice sysex;
+      sysex = rom[number_];
+
+      patch[v].activate(sysex);
+      voice[v].loadProgram(patch[v]);
+   }
+}
+
+//! Patch activated once and shared by every voice
+static void changeShared(unsigned number_)
+{
+   static DX7::Patch patch;
+
+   SysEx::Voice sysex;
+   sysex = rom[number_];
+
+   patch.activate(sysex);
+
+   for(unsigned v = 0; v < NUM_VOICES; ++v)
+      voice[v].loadProgram(patch);
+}
+
+//! Patch activated at build time
+static void changeImage(unsigned number_)
+{
+   static DX7::Patch patch;
+
+   patch.load(table_dx7_patch_2 + number_ * DX7::Patch::IMAGE_SIZE);
+
+   for(unsigned v = 0; v < NUM_VOICES; ++v)
+      voice[v].loadProgram(patch);
+}
+
+//! Activated patch found in the cache
+static void changeCached(unsigned number_)
+{
+   static DX7::PatchCache<> cache;
+
+   const DX7::Patch& patch = cache.find(number_, rom[number_]);
+
+   for(unsigned v = 0; v < NUM_VOICES; ++v)
+      voice[v].loadProgram(patch);
+}
+
+template <typename CHANGE>
+static double run(CHANGE change_)
+{
+   double best = 0.0;
+
+   for(unsigned i = 0; i < NUM_REPEAT; ++i)
+   {
+      double start = Bench::now();
+
+      // Cycle between a few programs, as during a performance
+      for(unsigned n = 0; n < NUM_CHANGE; ++n)
+         change_(n % 8);
+
+      double seconds = (Bench::now() - start) / NUM_CHANGE;
+
+      if ((i == 0) || (seconds < best))
+         best = seconds;
+   }
+
+   return best;
+}
+
+static void report(const char* name_, double seconds_)
+{
+   printf("%-10s %8.0f ns  %6.3f%% of a control tick\n",
+          name_, seconds_ * 1e9, seconds_ * 100 / TICK);
+}
+
+int main()
+{
+   printf("Program change latency for %u voices\n", NUM_VOICES);
+
+   report("per-voice", run(changePerVoice));
+   report("shared",    run(changeShared));
+   report("image",     run(changeImage));
+   report("cached",    run(changeCached));
+
+   return 0;
+}
@@ -0,0 +1,142 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief Scaling of native rendering with the number of RenderPool workers
+
+#include <cstdio>
+#include <initializer_list>
+#include <memory>
+#include <thread>
+
+#include "RenderPool.h"
+#include "VoicePartition.h"
+
+#include "DX7/Voice.h"
+
+#include "Table_dx7_rom_1.h"
+
+#include "Bench.h"
+
+static const unsigned SAMPLES_PER_TICK = 130;     //!< 49096 Hz / 375 Hz
+static const unsigned NUM_TICKS        = 375;     //!< 1 second of audio
+static const unsigned NUM_REPEAT       = 3;       //!< Best of N runs reported
+
+struct Result
+{
+   double   seconds;
+   uint64_t checksum;
+};
+
+template <unsigned N>
+static Result run(unsigned num_workers_)
+{
+   using Partition = VoicePartition<N, RenderPool::MAX_WORKERS>;
+
+   static DX7::Patch patch[32];
+   static Partition  partition;
+
+   uint32_t active[Partition::MASK_WORDS];
+
+   for(unsigned i = 0; i < Partition::MASK_WORDS; ++i)
+      active[i] = 0xFFFFFFFF;
+
+   // Fresh voices so every run renders the same output
+   std::unique_ptr<DX7::Voice<>[]> voice{new DX7::Voice<>[N]{}};
+
+   for(unsigned v = 0; v < N; ++v)
+   {
+      patch[v % 32].activate(SysEx::Voice{table_dx7_rom_1, v % 32});
+
+      voice[v].loadProgram(patch[v % 32]);
+   }
+
+   RenderPool pool{num_workers_};
+   Result     result{0.0, 0};
+
+   auto mix = [&voice](unsigned worker_, int32_t* buffer_, unsigned n_)
+   {
+      DX7::Voice<>* item[N];
+      unsigned      count = 0;
+
+      for(unsigned v = 0; v < N; ++v)
+      {
+         if ((partition.getMask(worker_)[v / 32] >> (v % 32)) & 1)
+            item[count++] = &voice[v];
+      }
+
+      for(unsigned i = 0; i < n_; ++i)
+         buffer_[i] = 0;
+
+      DX7::Voice<>::render(item, count, buffer_, n_);
+   };
+
+   double start = Bench::now();
+
+   for(unsigned tick = 0; tick < NUM_TICKS; ++tick)
+   {
+      if ((tick % 375) == 0)
+      {
+         for(unsigned v = 0; v < N; ++v)
+            voice[v].noteOn(24 + (v * 7) % 72, 100);
+      }
+
+      partition.assign(active, pool.getNumWorkers(),
+                       [&voice](unsigned index_) { return voice[index_].getRenderCost(); });
+
+      int32_t buffer[SAMPLES_PER_TICK];
+
+      pool.mix(buffer, SAMPLES_PER_TICK, mix);
+
+      for(unsigned v = 0; v < N; ++v)
+         voice[v].tick();
+
+      for(unsigned i = 0; i < SAMPLES_PER_TICK; ++i)
+         result.checksum = (result.checksum ^ uint32_t(buffer[i])) * 0x100000001B3;
+   }
+
+   result.seconds = Bench::now() - start;
+
+   return result;
+}
+
+template <unsigned N>
+static void bench()
+{
+   double   single   = 0.0;
+   uint64_t checksum = 0;
+
+   for(unsigned num_workers : {1, 2, 4, 8})
+   {
+      Result best{};
+
+      for(unsigned i = 0; i < NUM_REPEAT; ++i)
+      {
+         Result result = run<N>(num_workers);
+
+         if ((i == 0) || (result.seconds < best.seconds))
+            best = result;
+      }
+
+      if (num_workers == 1)
+      {
+         single   = best.seconds;
+         checksum = best.checksum;
+      }
+
+      printf("%3u  %u workers  %7.3f s  %6.1fx real-time  %5.2fx speed-up%s\n",
+             N, num_workers, best.seconds, 1.0 / best.seconds, single / best.seconds,
+             best.checksum == checksum ? "" : "  MISMATCH");
+   }
+}
+
+int main()
+{
+   printf("%u hardware threads\n", std::thread::hardware_concurrency());
+
+   bench<128>();
+   bench<256>();
+
+   return 0;
+}
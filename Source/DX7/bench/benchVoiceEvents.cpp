@@ -0,0 +1,99 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief Measure MIDI event throughput into sounding voices for dense streams
+//        of controller, pitch bend and aftertouch messages
+
+#include <cstdio>
+#include <initializer_list>
+
+#include "DX7/Voice.h"
+
+#include "Table_dx7_rom_1.h"
+
+#include "Bench.h"
+
+static const unsigned NUM_EVENTS = 100000;  //!< Channel events per run
+static const unsigned NUM_REPEAT = 7;       //!< Best of N runs reported
+
+enum Stream { MOD_WHEEL, PITCH_BEND, PRESSURE, MIXED };
+
+static const char* stream_name[] = {"mod wheel", "pitch bend", "pressure", "mixed"};
+
+//! Send one channel event, SynthVoice applies it once to the channel
+//! shared by the voices
+static void send(DX7::Channel& channel_, Stream stream_, unsigned i_)
+{
+   uint8_t value = i_ & 0x7F;
+
+   if (stream_ == MIXED)
+      stream_ = Stream(i_ % 3);
+
+   switch(stream_)
+   {
+   case MOD_WHEEL:  channel_.setControl(1, value);                 break;
+   case PITCH_BEND: channel_.setPitchBend((value << 6) - 0x2000);   break;
+   case PRESSURE:   channel_.setPressure(value);                   break;
+   default: break;
+   }
+}
+
+template <typename VOICE, unsigned N>
+static double run(VOICE (&voice_)[N], DX7::Channel& channel_, Stream stream_)
+{
+   static DX7::Patch patch[32];
+
+   for(unsigned v = 0; v < N; ++v)
+   {
+      patch[v % 32].activate(SysEx::Voice{table_dx7_rom_1, v % 32});
+
+      voice_[v].loadProgram(patch[v % 32]);
+      voice_[v].setChannel(channel_);
+      voice_[v].noteOn(24 + (v * 7) % 72, 100);
+   }
+
+   double start = Bench::now();
+
+   for(unsigned i = 0; i < NUM_EVENTS; ++i)
+      send(channel_, stream_, i);
+
+   return Bench::now() - start;
+}
+
+template <unsigned N>
+static void bench()
+{
+   static DX7::Voice<> voice[N]{};
+   static DX7::Channel channel{};
+
+   for(Stream stream : {MOD_WHEEL, PITCH_BEND, PRESSURE, MIXED})
+   {
+      double best = 0.0;
+
+      for(unsigned i = 0; i < NUM_REPEAT; ++i)
+      {
+         double seconds = run(voice, channel, stream);
+
+         if ((i == 0) || (seconds < best))
+            best = seconds;
+      }
+
+      printf("%3u  %-10s  %7.2f ms  %7.2f M events/s  %5.1f ns/voice event\n",
+             N, stream_name[stream], best * 1e3,
+             NUM_EVENTS / best / 1e6,
+             best * 1e9 / (double(NUM_EVENTS) * N));
+   }
+}
+
+int main()
+{
+   printf("Voice %u bytes\n", unsigned(sizeof(DX7::Voice<>)));
+
+   bench<1>();
+   bench<16>();
+   bench<64>();
+
+   return 0;
+}
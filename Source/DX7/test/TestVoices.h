@@ -0,0 +1,56 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief Sounding voices for the render and partition tests
+
+#pragma once
+
+#include <cstdint>
+
+#include "DX7/Patch.h"
+#include "DX7/Voice.h"
+
+#include "Table_dx7_rom_1.h"
+
+namespace TestVoices {
+
+//! The ROM 1 patches activated once and shared by the voices
+inline const DX7::Patch& romPatch(unsigned index_)
+{
+   static DX7::Patch patch[32];
+   static bool       activated = false;
+
+   if (not activated)
+   {
+      for(unsigned i = 0; i < 32; ++i)
+         patch[i].activate(SysEx::Voice{table_dx7_rom_1, i});
+
+      activated = true;
+   }
+
+   return patch[index_ % 32];
+}
+
+//! Mute every voice then start notes on the voices in mask_ (bit n for
+//! voice n). Voice n plays note first_note_ + n with ROM 1 patch 2n, so
+//! neighbouring voices use different algorithms
+template <unsigned N>
+void start(DX7::Voice<> (&voice_)[N], unsigned first_note_, uint32_t mask_ = ~0u)
+{
+   static_assert(N <= 32, "mask_ is 32-bit");
+
+   for(unsigned v = 0; v < N; ++v)
+   {
+      voice_[v].mute();
+
+      if ((mask_ & (1u << v)) == 0)
+         continue;
+
+      voice_[v].loadProgram(romPatch(v * 2));
+      voice_[v].noteOn(first_note_ + v, 100);
+   }
+}
+
+} // namespace TestVoices
@@ -0,0 +1,95 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+#include "DX7/Channel.h"
+#include "DX7/Patch.h"
+#include "DX7/Voice.h"
+
+#include "Table_dx7_rom_1.h"
+
+#include "STB/Test.h"
+
+TEST(Channel, idle)
+{
+   const DX7::Channel& channel = DX7::Channel::idle();
+
+   EXPECT_EQ(0, channel.getPitchBend());
+   EXPECT_EQ(0, channel.getPressure());
+   EXPECT_EQ(0, channel.getModulation().getAmpMod());
+   EXPECT_EQ(0, channel.getModulation().getPitchMod());
+}
+
+TEST(Channel, modulation)
+{
+   SysEx::Param param{};
+
+   param.mod_wheel_range    = 99;
+   param.mod_wheel_assign   = 0b001;   // pitch
+   param.after_touch_range  = 50;
+   param.after_touch_assign = 0b010;   // amp
+
+   DX7::Channel channel;
+   channel.loadParam(param);
+
+   channel.setControl(1, 0x80);
+   channel.setPressure(0x40);
+
+   EXPECT_EQ(0x80, channel.getControl(1));
+   EXPECT_EQ(((0x80 * ((99 * 660) >> 8)) >> 8), channel.getModulation().getPitchMod());
+   EXPECT_EQ(((0x40 * ((50 * 660) >> 8)) >> 8), channel.getModulation().getAmpMod());
+
+   // Controls that are not modulation sources only update the state
+   channel.setControl(7, 100);
+
+   EXPECT_EQ(100, channel.getControl(7));
+   EXPECT_EQ(((0x80 * ((99 * 660) >> 8)) >> 8), channel.getModulation().getPitchMod());
+}
+
+TEST(Channel, shared)
+{
+   static const unsigned NUM_VOICES = 4;
+
+   DX7::Patch   patch{SysEx::Voice{table_dx7_rom_1, 10}};
+   DX7::Channel channel;
+
+   static DX7::Voice<> voice[NUM_VOICES]{};
+   static DX7::Voice<> ref{};
+
+   // A pitch bend on the channel is seen by every voice following it
+   channel.setPitchBend(0x1000);
+
+   for(unsigned v = 0; v < NUM_VOICES; ++v)
+   {
+      voice[v].loadProgram(patch);
+      voice[v].setChannel(channel);
+      voice[v].noteOn(60, 100);
+   }
+
+   ref.loadProgram(patch);
+   ref.noteOn(60, 100);
+
+   unsigned differ = 0;
+
+   for(unsigned tick = 0; tick < 100; ++tick)
+   {
+      for(unsigned v = 0; v < NUM_VOICES; ++v)
+         voice[v].tick();
+
+      ref.tick();
+
+      for(unsigned i = 0; i < 130; ++i)
+      {
+         int32_t sample = voice[0]();
+
+         for(unsigned v = 1; v < NUM_VOICES; ++v)
+            EXPECT_EQ(sample, voice[v]());
+
+         if (sample != ref())
+            ++differ;
+      }
+   }
+
+   EXPECT_GT(differ, 0u);
+}
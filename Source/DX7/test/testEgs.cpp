@@ -6,7 +6,8 @@
 #include "DX7/Egs.h"
 
 #include "DX7/SysEx.h"
-#include "DX7/DX7Firmware.h"
+#include "DX7/Firmware.h"
+#include "DX7/Patch.h"
 
 #include "Table_dx7_rom_1.h"
 
@@ -20,11 +21,12 @@
 TEST(Egs, old_test)
 {
    unsigned      patch_index{0};
-   SysEx::Voice  patch{table_dx7_rom_1, patch_index};
-   Egs           hw;
+   SysEx::Voice  sysex{table_dx7_rom_1, patch_index};
+   DX7::Patch    patch{sysex};
+   Egs<>         hw;
    DX7::Firmware fw{hw};
 
-   fw.loadVoice(&patch);
+   fw.loadVoice(patch);
 
    for(unsigned t = 0; t < 2 * (49096); t++)
    {
@@ -35,3 +37,41 @@ TEST(Egs, old_test)
       DEBUG("%u,0x%04x\n", t, amp14);
    }
 }
+
+TEST(Egs, send_freq)
+{
+   Egs<> hw;
+
+   for(unsigned i = 0; i < Egs<>::NUM_OP; ++i)
+   {
+      hw.op[i].setPitchRatio(0x8000 + i * 0x400);
+   }
+
+   hw.setEgsVoicePitch(0x4000);
+   hw.setEgsPitchMod(0);
+   hw.sendEgsFreq();
+
+   uint32_t phase_inc = hw.getPhaseInc(0);
+   EXPECT_NE(0, phase_inc);
+
+   // Frequency is not re-sent when nothing has changed
+   hw.getState().phaseInc(0) = 0;
+   hw.setEgsVoicePitch(0x4000);
+   hw.setEgsPitchMod(0);
+   hw.sendEgsFreq();
+   EXPECT_EQ(0, hw.getPhaseInc(0));
+
+   // Pitch modulation change re-sends every operator
+   hw.setEgsPitchMod(0x100);
+   hw.sendEgsFreq();
+   EXPECT_NE(0, hw.getPhaseInc(0));
+   EXPECT_NE(phase_inc, hw.getPhaseInc(0));
+
+   // Patch change only re-sends the changed operator
+   hw.getState().phaseInc(0) = 0;
+   hw.getState().phaseInc(1) = 0;
+   hw.op[1].setDetune(1);
+   hw.sendEgsFreq();
+   EXPECT_EQ(0, hw.getPhaseInc(0));
+   EXPECT_NE(0, hw.getPhaseInc(1));
+}
@@ -30,6 +30,7 @@ public:
       EXPECT_GT(0x40, rate_6_);
 
       rate_6[i] = rate_6_;
+      ++num_rate_write;
    }
 
    void setAmpMod(unsigned amp_mod_12_)
@@ -37,6 +38,7 @@ public:
       EXPECT_GT(0x1000, amp_mod_12_);
 
       amp_mod_12 = amp_mod_12_;
+      ++num_amp_mod_write;
    }
 
    static const unsigned NUM_CONTROL = 2;
@@ -44,6 +46,8 @@ public:
    uint16_t amp_mod_12{0};
    uint8_t  atten_8[NUM_CONTROL] = {};
    uint8_t  rate_6[NUM_CONTROL] = {};
+   unsigned num_rate_write{0};
+   unsigned num_amp_mod_write{0};
 };
 
 
@@ -75,3 +79,54 @@ TEST(EgsOpState, basic)
    op.updateRates(0x1000);
    op.computeOpsFreq14(0x1000, 0x0000);
 }
+
+
+static const unsigned NUM_CONTROL_WRITES = TestEG::NUM_CONTROL;
+
+TEST(EgsOpState, changes)
+{
+   TestEG             eg{};
+   EgsOpState<TestEG> op;
+
+   op.init(&eg);
+
+   op.setPitchRatio(0x1000);
+   op.setEgRate(0, 0x10);
+   op.setAmpModSens(1);
+
+   // Everything is sent initially
+   EXPECT_TRUE(op.isFreqChanged());
+   op.computeOpsFreq14(0x1000, 0x0000);
+   EXPECT_FALSE(op.isFreqChanged());
+
+   op.updateRates(0x1000, /* pitch_changed */ false);
+   EXPECT_EQ(NUM_CONTROL_WRITES, eg.num_rate_write);
+
+   op.setAmpMod(0x80);
+   EXPECT_EQ(1, eg.num_amp_mod_write);
+
+   // Nothing changed
+   op.updateRates(0x1000, /* pitch_changed */ false);
+   EXPECT_EQ(NUM_CONTROL_WRITES, eg.num_rate_write);
+
+   op.setAmpMod(0x80);
+   EXPECT_EQ(1, eg.num_amp_mod_write);
+
+   // Inputs changed
+   op.updateRates(0x1200, /* pitch_changed */ true);
+   EXPECT_EQ(2 * NUM_CONTROL_WRITES, eg.num_rate_write);
+
+   op.setEgRate(1, 0x20);
+   op.updateRates(0x1200, /* pitch_changed */ false);
+   EXPECT_EQ(3 * NUM_CONTROL_WRITES, eg.num_rate_write);
+
+   op.setAmpMod(0x81);
+   EXPECT_EQ(2, eg.num_amp_mod_write);
+
+   op.setAmpModSens(2);
+   op.setAmpMod(0x81);
+   EXPECT_EQ(3, eg.num_amp_mod_write);
+
+   op.setDetune(1);
+   EXPECT_TRUE(op.isFreqChanged());
+}
@@ -7,6 +7,109 @@
 
 #include "STB/Test.h"
 
+//! Reference EG that steps the attenuation towards the target on every
+//! sample, the original implementation of EnvGen
+class RefEnvGen
+{
+public:
+   RefEnvGen()
+   {
+      setPhase(END);
+   }
+
+   void setAtten8(unsigned index_, unsigned atten8_)
+   {
+      unsigned p = index_ == EnvGen::NUM_CONTROL - 1 ? unsigned(RELEASE) : index_;
+
+      phase[p].atten = (atten8_ << 16) | (atten8_ << 8) | atten8_;
+   }
+
+   void setRate6(unsigned index_, uint8_t rate6_)
+   {
+      unsigned p = index_ == 3 ? unsigned(RELEASE) : index_;
+
+      phase[p].rate = table_dx_exp_19[rate6_];
+   }
+
+   void setAmpMod(unsigned amp_mod_12_) { amp_mod_12 = amp_mod_12_; }
+
+   void keyOn()
+   {
+      phase[SUSTAIN].atten = phase[DECAY2].atten;
+      phase[END].atten     = phase[RELEASE].atten;
+      attenuation          = phase[RELEASE].atten;
+
+      setPhase(ATTACK);
+   }
+
+   void keyOff()
+   {
+      if (index < RELEASE)
+         setPhase(RELEASE);
+   }
+
+   uint32_t getAtten12()
+   {
+      if (attenuation >= target.atten)
+      {
+         attenuation -= target.rate;
+         if (attenuation <= target.atten)
+         {
+            attenuation = target.atten;
+            nextPhase();
+         }
+      }
+      else
+      {
+         attenuation += target.rate / 4;
+         if (attenuation >= target.atten)
+         {
+            attenuation = target.atten;
+            nextPhase();
+         }
+      }
+
+      return (attenuation >> 12) + amp_mod_12;
+   }
+
+   uint32_t dbgInternal() const { return attenuation; }
+   unsigned dbgPhase() const { return index; }
+
+private:
+   enum { ATTACK, DECAY1, DECAY2, SUSTAIN, RELEASE, END, NUM_PHASE };
+
+   void nextPhase()
+   {
+      if ((index != SUSTAIN) && (index != END))
+         setPhase(index + 1);
+   }
+
+   void setPhase(unsigned index_)
+   {
+      index  = index_;
+      target = phase[index];
+   }
+
+   struct Phase
+   {
+      int32_t rate{0};
+      int32_t atten{0};
+   };
+
+   int32_t  attenuation{(1 << 24) - 1};
+   Phase    target{};
+   uint32_t amp_mod_12{0};
+   unsigned index{};
+   Phase    phase[NUM_PHASE];
+};
+
+//! Simple deterministic pseudo random sequence
+static uint32_t rand32(uint32_t& state_)
+{
+   state_ = state_ * 1664525 + 1013904223;
+   return state_ >> 8;
+}
+
 
 TEST(EnvGen, basic)
 {
@@ -241,3 +344,107 @@ TEST(EnvGen, decay)
 
    fclose(fp);
 }
+
+TEST(EnvGen, reference)
+{
+   static const unsigned NUM_NOTES = 200;
+   static const unsigned BLOCK     = 37;
+
+   uint32_t seed = 1;
+
+   RefEnvGen ref{};
+   EnvGen    env_gen{};
+   EnvGen    block_env_gen{};
+
+   unsigned mismatch = 0;
+
+   for(unsigned note = 0; note < NUM_NOTES; ++note)
+   {
+      // Mostly slow rates, with an occasional extreme rate or level
+      for(unsigned i = 0; i < EnvGen::NUM_CONTROL; ++i)
+      {
+         uint8_t  rate6  = (rand32(seed) % 8) == 0 ? 63 : 20 + rand32(seed) % 40;
+         unsigned atten8 = (rand32(seed) % 8) == 0 ? 0xFF : rand32(seed) % 256;
+
+         ref.setRate6(i, rate6);
+         env_gen.setRate6(i, rate6);
+         block_env_gen.setRate6(i, rate6);
+
+         ref.setAtten8(i, atten8);
+         env_gen.setAtten8(i, atten8);
+         block_env_gen.setAtten8(i, atten8);
+      }
+
+      unsigned key_on  = rand32(seed) % 1000;
+      unsigned key_off = key_on + rand32(seed) % 20000;
+      unsigned length  = key_off + rand32(seed) % 20000;
+      unsigned change  = rand32(seed) % length;
+
+      uint32_t atten12[BLOCK];
+      unsigned t = 0;
+      unsigned n = 0;
+
+      for(unsigned i = 0; i < length; ++i)
+      {
+         if (i == key_on)
+         {
+            ref.keyOn();
+            env_gen.keyOn();
+            block_env_gen.keyOn();
+         }
+         else if (i == key_off)
+         {
+            ref.keyOff();
+            env_gen.keyOff();
+            block_env_gen.keyOff();
+         }
+         else if (i == change)
+         {
+            // Parameter changes while a phase is in progress
+            uint8_t  rate6  = rand32(seed) % 64;
+            unsigned atten8 = rand32(seed) % 256;
+            unsigned amp    = rand32(seed) % 0x400;
+
+            ref.setRate6(1, rate6);
+            env_gen.setRate6(1, rate6);
+            block_env_gen.setRate6(1, rate6);
+
+            ref.setAtten8(2, atten8);
+            env_gen.setAtten8(2, atten8);
+            block_env_gen.setAtten8(2, atten8);
+
+            ref.setAmpMod(amp);
+            env_gen.setAmpMod(amp);
+            block_env_gen.setAmpMod(amp);
+         }
+
+         uint32_t expected = ref.getAtten12();
+
+         if ((env_gen.getAtten12() != expected) ||
+             (env_gen.dbgInternal() != ref.dbgInternal()) ||
+             (env_gen.dbgPhase() != ref.dbgPhase()))
+         {
+            ++mismatch;
+         }
+
+         // Block interface, blocks end before each event
+         if (t == n)
+         {
+            n = BLOCK;
+
+            if ((key_on > i) && (key_on - i < n))   n = key_on - i;
+            if ((key_off > i) && (key_off - i < n)) n = key_off - i;
+            if ((change > i) && (change - i < n))   n = change - i;
+            if (length - i < n)                     n = length - i;
+
+            block_env_gen.getAtten12(atten12, n);
+            t = 0;
+         }
+
+         if (atten12[t++] != expected)
+            ++mismatch;
+      }
+   }
+
+   EXPECT_EQ(0, mismatch);
+}
@@ -0,0 +1,107 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+#include <thread>
+
+#include "EventQueue.h"
+
+#include "STB/Test.h"
+
+struct Event
+{
+   uint32_t time;
+   uint8_t  data;
+};
+
+TEST(EventQueue, order)
+{
+   EventQueue<Event, 4> queue;
+
+   EXPECT_TRUE(queue.empty());
+   EXPECT_EQ(nullptr, queue.front());
+
+   for(unsigned i = 0; i < 4; ++i)
+   {
+      EXPECT_TRUE(queue.push(Event{i, uint8_t(i + 10)}));
+   }
+
+   // Full
+   EXPECT_FALSE(queue.push(Event{4, 14}));
+
+   for(unsigned i = 0; i < 4; ++i)
+   {
+      const Event* event = queue.front();
+
+      EXPECT_NE(nullptr, event);
+      EXPECT_EQ(i, event->time);
+      EXPECT_EQ(i + 10, event->data);
+
+      queue.pop();
+   }
+
+   EXPECT_TRUE(queue.empty());
+}
+
+TEST(EventQueue, wrap)
+{
+   EventQueue<Event, 8> queue;
+
+   for(unsigned i = 0; i < 100; ++i)
+   {
+      EXPECT_TRUE(queue.push(Event{i, 0}));
+      EXPECT_TRUE(queue.push(Event{i + 1000, 0}));
+
+      EXPECT_EQ(i, queue.front()->time);
+      queue.pop();
+
+      EXPECT_EQ(i + 1000, queue.front()->time);
+      queue.pop();
+   }
+
+   EXPECT_TRUE(queue.empty());
+}
+
+TEST(EventQueue, threads)
+{
+   static const uint32_t NUM_EVENTS = 100000;
+
+   static EventQueue<Event, 64> queue;
+
+   std::thread producer{[]()
+                        {
+                           for(uint32_t i = 0; i < NUM_EVENTS; ++i)
+                           {
+                              while(not queue.push(Event{i, uint8_t(i)}))
+                              {
+                                 std::this_thread::yield();
+                              }
+                           }
+                        }};
+
+   uint32_t next   = 0;
+   unsigned errors = 0;
+
+   while(next < NUM_EVENTS)
+   {
+      const Event* event = queue.front();
+
+      if (event == nullptr)
+      {
+         std::this_thread::yield();
+         continue;
+      }
+
+      if ((event->time != next) || (event->data != uint8_t(next)))
+         ++errors;
+
+      queue.pop();
+      ++next;
+   }
+
+   producer.join();
+
+   EXPECT_EQ(0u, errors);
+   EXPECT_TRUE(queue.empty());
+}
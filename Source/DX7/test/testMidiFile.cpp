@@ -0,0 +1,81 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+#include "MidiFile.h"
+
+#include "STB/Test.h"
+
+static const unsigned SAMPLE_RATE = 48000;
+
+//! Format 1, 2 tracks, 96 ticks per quarter note
+static const uint8_t smf[] =
+{
+   'M', 'T', 'h', 'd', 0, 0, 0, 6,   0, 1,   0, 2,   0, 96,
+
+   // Tempo track, 120 bpm then 60 bpm after one quarter note
+   'M', 'T', 'r', 'k', 0, 0, 0, 18,
+   0x00, 0xFF, 0x51, 0x03, 0x07, 0xA1, 0x20,
+   0x60, 0xFF, 0x51, 0x03, 0x0F, 0x42, 0x40,
+   0x00, 0xFF, 0x2F, 0x00,
+
+   // Notes with running status and a SYSEX message
+   'M', 'T', 'r', 'k', 0, 0, 0, 28,
+   0x00, 0x90, 60, 100,
+   0x30, 64, 90,                          // running status
+   0x00, 0xF0, 0x03, 0x43, 0x10, 0xF7,    // SYSEX skipped
+   0x30, 0x80, 60, 0,
+   0x60, 0x90, 64, 0,                     // note on velocity 0
+   0x00, 0xC1, 5,
+   0x60, 0xFF, 0x2F, 0x00
+};
+
+TEST(MidiFile, parse)
+{
+   MidiFile file;
+
+   EXPECT_TRUE(file.parse(smf, sizeof(smf), SAMPLE_RATE));
+
+   const auto& events = file.getEvents();
+
+   EXPECT_EQ(5u, events.size());
+
+   // 48 ticks at 120 bpm is 0.25 s
+   EXPECT_EQ(0u,     events[0].time);
+   EXPECT_EQ(0x90,   events[0].status);
+   EXPECT_EQ(60,     events[0].data1);
+   EXPECT_EQ(100,    events[0].data2);
+
+   EXPECT_EQ(12000u, events[1].time);
+   EXPECT_EQ(0x90,   events[1].status);
+   EXPECT_EQ(64,     events[1].data1);
+
+   EXPECT_EQ(24000u, events[2].time);
+   EXPECT_EQ(0x80,   events[2].status);
+
+   // 96 ticks at 60 bpm is 1 s
+   EXPECT_EQ(72000u, events[3].time);
+   EXPECT_EQ(0x90,   events[3].status);
+   EXPECT_EQ(0,      events[3].data2);
+
+   EXPECT_EQ(72000u, events[4].time);
+   EXPECT_EQ(0xC1,   events[4].status);
+   EXPECT_EQ(5,      events[4].data1);
+
+   EXPECT_EQ(120000u, file.getLength());
+}
+
+TEST(MidiFile, invalid)
+{
+   MidiFile file;
+
+   static const uint8_t not_smf[] = {'R', 'I', 'F', 'F', 0, 0, 0, 6, 0, 0, 0, 1, 0, 96};
+
+   EXPECT_FALSE(file.parse(not_smf, sizeof(not_smf), SAMPLE_RATE));
+
+   // Truncated track
+   EXPECT_FALSE(file.parse(smf, sizeof(smf) - 8, SAMPLE_RATE));
+
+   EXPECT_FALSE(file.load("missing.mid", SAMPLE_RATE));
+}
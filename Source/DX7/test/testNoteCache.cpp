@@ -0,0 +1,83 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+#include "DX7/NoteCache.h"
+#include "DX7/Synth.h"
+
+#include "STB/Test.h"
+
+static const unsigned DAC_FREQ   = 49096;
+static const unsigned TICK_RATE  = 375;
+static const unsigned NUM_VOICES = 16;
+static const unsigned BLOCK      = 1000;
+
+using TestSynth = DX7::Synth<NUM_VOICES, /* AMP_N */ 4>;
+using Cache     = DX7::NoteCache<DX7::Voice<>, NUM_VOICES>;
+
+//! A note repeated every second, a whole number of control ticks, so
+//! each repeat starts in the same state
+static void play(TestSynth& synth_, unsigned program_, bool interrupt_)
+{
+   synth_.init();
+   synth_.setTickRate(DAC_FREQ, TICK_RATE);
+   synth_.setEventTime(0);
+   synth_.programChange(0, program_);
+
+   for(unsigned i = 0; i < 4; ++i)
+   {
+      synth_.setEventTime(i * DAC_FREQ);
+      synth_.noteOn(60, 100);
+
+      if (interrupt_ && (i == 2))
+      {
+         // Change a replaying note part way through
+         synth_.setEventTime(i * DAC_FREQ + DAC_FREQ / 8);
+         synth_.pitchBend(0x800);
+      }
+
+      synth_.setEventTime(i * DAC_FREQ + DAC_FREQ / 4);
+      synth_.noteOff(60, 0);
+   }
+}
+
+static void check(TestSynth& synth_, TestSynth& cached_, bool interrupt_)
+{
+   static int32_t ref[BLOCK];
+   static int32_t out[BLOCK];
+
+   Cache cache{/* max_bytes */ 16 << 20};
+
+   // MARIMBA has oscillator and LFO key sync
+   play(synth_, /* program */ 21, interrupt_);
+   play(cached_, /* program */ 21, interrupt_);
+
+   for(unsigned block = 0; block < (4 * DAC_FREQ / BLOCK); ++block)
+   {
+      synth_.render(ref, BLOCK);
+      cached_.renderCached(cache, out, BLOCK);
+
+      for(unsigned i = 0; i < BLOCK; ++i)
+         EXPECT_EQ(ref[i], out[i]);
+   }
+
+   EXPECT_NE(0u, cache.hits);
+   EXPECT_NE(0u, cache.replayed);
+}
+
+TEST(NoteCache, repeat)
+{
+   static TestSynth synth;
+   static TestSynth cached;
+
+   check(synth, cached, /* interrupt */ false);
+}
+
+TEST(NoteCache, interrupt)
+{
+   static TestSynth synth;
+   static TestSynth cached;
+
+   check(synth, cached, /* interrupt */ true);
+}
@@ -267,3 +267,25 @@ TEST(Ops, freq)
    }
 }
 
+
+TEST(Ops, silent)
+{
+   // Any attenuation at or above the silent threshold gives zero output
+   for(uint32_t log_14 = SingleOp::SILENT_LOG_14; log_14 <= 0x3FFF; ++log_14)
+   {
+      EXPECT_EQ(0, table_dx_exp_14[log_14]);
+   }
+
+   SingleOp    ops{};
+   AlwaysOnEG* eg = ops.getEgPointer(0);
+
+   ops.noteOn(/* note14 (A4) */ 0x1000);
+
+   // Up to the maximum attenuation with amplitude modulation
+   for(uint32_t atten12 = SingleOp::SILENT_ATTEN_12; atten12 <= 0x1FFE; ++atten12)
+   {
+      eg->setAtten12(atten12);
+
+      EXPECT_EQ(0, ops.getSample());
+   }
+}
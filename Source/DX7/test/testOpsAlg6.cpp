@@ -0,0 +1,186 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+#include "DX7/OpsAlg6.h"
+
+#include "STB/Test.h"
+
+//! Simple EG that slowly sweeps the attenuation so the test is not trivial
+class SweepEG
+{
+public:
+   SweepEG() = default;
+
+   uint32_t getAtten12()
+   {
+      atten12 = (atten12 + 1) & 0x7FF;
+      return atten12;
+   }
+
+   uint32_t getMinAtten12(unsigned) const { return 0; }
+
+   void skip(unsigned n_)
+   {
+      atten12 = (atten12 + n_) & 0x7FF;
+   }
+
+private:
+   uint32_t atten12{0x000};
+};
+
+//! EG with a constant attenuation
+class ConstEG
+{
+public:
+   ConstEG() = default;
+
+   void setAtten12(uint32_t atten12_) { atten12 = atten12_; }
+
+   uint32_t getAtten12() { return atten12; }
+
+   uint32_t getMinAtten12(unsigned) const { return atten12; }
+
+   void skip(unsigned) {}
+
+private:
+   uint32_t atten12{0x000};
+};
+
+
+template <typename EG>
+static void setup(DX::OpsAlg6<EG>& ops_, uint8_t alg_)
+{
+   ops_.setOpsAlg(alg_);
+   ops_.setOpsFdbk(7);
+   ops_.setOpsSync(true);
+
+   for(unsigned i = 0; i < 6; ++i)
+   {
+      ops_.setOpsFreq(i, 0x1000 + i * 0x123);
+   }
+
+   ops_.keyOn();
+}
+
+
+TEST(OpsAlg6, render)
+{
+   static const unsigned BLOCK = 130;
+
+   for(uint8_t alg = 0; alg < 32; ++alg)
+   {
+      DX::OpsAlg6<SweepEG> ref{};
+      DX::OpsAlg6<SweepEG> blk{};
+
+      setup(ref, alg);
+      setup(blk, alg);
+
+      for(unsigned block = 0; block < 20; ++block)
+      {
+         int32_t buffer[BLOCK];
+
+         for(unsigned i = 0; i < BLOCK; ++i)
+            buffer[i] = 0;
+
+         blk.render(buffer, BLOCK);
+
+         for(unsigned i = 0; i < BLOCK; ++i)
+         {
+            EXPECT_EQ(ref(), buffer[i]);
+         }
+      }
+   }
+}
+
+TEST(OpsAlg6, cull)
+{
+   static const unsigned BLOCK = 130;
+
+   for(uint8_t alg = 0; alg < 32; ++alg)
+   {
+      DX::OpsAlg6<ConstEG> ref{};
+      DX::OpsAlg6<ConstEG> blk{};
+
+      setup(ref, alg);
+      setup(blk, alg);
+
+      for(unsigned block = 0; block < 4; ++block)
+      {
+         // Silent for the first two blocks
+         uint32_t atten12 = block < 2 ? 0xE00 : 0x000;
+
+         for(unsigned i = 0; i < 6; ++i)
+         {
+            ref.getEgPointer(i)->setAtten12(atten12);
+            blk.getEgPointer(i)->setAtten12(atten12);
+         }
+
+         int32_t buffer[BLOCK];
+
+         for(unsigned i = 0; i < BLOCK; ++i)
+            buffer[i] = 0;
+
+         blk.render(buffer, BLOCK);
+
+         for(unsigned i = 0; i < BLOCK; ++i)
+         {
+            EXPECT_EQ(ref(), buffer[i]);
+         }
+      }
+
+      // Per-sample render is never culled
+      EXPECT_EQ(6 * BLOCK * 4, ref.getStats().op_evals);
+      EXPECT_EQ(0,             ref.getStats().op_skipped);
+      EXPECT_EQ(0,             ref.getStats().voice_culled);
+
+      EXPECT_EQ(6 * BLOCK * 4, blk.getStats().op_evals);
+      EXPECT_EQ(6 * BLOCK * 2, blk.getStats().op_skipped);
+      EXPECT_EQ(2,             blk.getStats().voice_culled);
+   }
+}
+
+TEST(OpsAlg6, skip)
+{
+   static const unsigned BLOCK = 130;
+
+   for(uint8_t alg = 0; alg < 32; ++alg)
+   {
+      DX::OpsAlg6<SweepEG> ref{};
+      DX::OpsAlg6<SweepEG> blk{};
+
+      setup(ref, alg);
+      setup(blk, alg);
+
+      for(unsigned block = 0; block < 20; ++block)
+      {
+         // Skip every other block, the feedback loop must be left as
+         // rendering would leave it
+         if ((block & 1) == 0)
+         {
+            blk.skip(BLOCK);
+
+            for(unsigned i = 0; i < BLOCK; ++i)
+               (void) ref();
+
+            continue;
+         }
+
+         int32_t buffer[BLOCK];
+
+         for(unsigned i = 0; i < BLOCK; ++i)
+            buffer[i] = 0;
+
+         blk.render(buffer, BLOCK);
+
+         for(unsigned i = 0; i < BLOCK; ++i)
+         {
+            EXPECT_EQ(ref(), buffer[i]);
+         }
+      }
+
+      EXPECT_EQ(6 * BLOCK * 20, blk.getStats().op_evals);
+      EXPECT_NE(0,              blk.getStats().op_skipped);
+   }
+}
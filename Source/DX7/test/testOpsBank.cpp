@@ -0,0 +1,69 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+#include "DX7/Voice.h"
+#include "DX7/OpsBank.h"
+
+#include "Table_dx7_rom_1.h"
+
+#include "STB/Test.h"
+
+TEST(OpsBank, voice)
+{
+   static const unsigned NUM_VOICES = 12;
+   static const unsigned BLOCK      = 130;
+
+   // Value initialised so that both sets of voices start from the same state
+   static DX7::Voice<>  ref[NUM_VOICES]{};
+   static DX7::BankVoice bank_voice[NUM_VOICES]{};
+   static DX::OpsBank<NUM_VOICES, /* NUM_OP */ 6, EnvGen> bank;
+   static DX7::Patch     patch[NUM_VOICES];
+
+   DX7::Voice<>*  ref_ptr[NUM_VOICES];
+   DX7::BankVoice* bank_ptr[NUM_VOICES];
+
+   for(unsigned v = 0; v < NUM_VOICES; ++v)
+   {
+      bank_voice[v].attach(bank, v);
+
+      // Both voices play the same activated patch
+      patch[v].activate(SysEx::Voice{table_dx7_rom_1, v * 2});
+
+      ref[v].loadProgram(patch[v]);
+      ref[v].noteOn(36 + v * 5, 100);
+      ref_ptr[v] = &ref[v];
+
+      bank_voice[v].loadProgram(patch[v]);
+      bank_voice[v].noteOn(36 + v * 5, 100);
+      bank_ptr[v] = &bank_voice[v];
+   }
+
+   unsigned non_zero = 0;
+
+   for(unsigned tick = 0; tick < 200; ++tick)
+   {
+      int32_t expected[BLOCK] = {};
+      int32_t actual[BLOCK] = {};
+
+      DX7::Voice<>::render(ref_ptr, NUM_VOICES, expected, BLOCK);
+      DX7::BankVoice::render(bank_ptr, NUM_VOICES, actual, BLOCK);
+
+      for(unsigned i = 0; i < BLOCK; ++i)
+      {
+         EXPECT_EQ(expected[i], actual[i]);
+
+         if (actual[i] != 0)
+            ++non_zero;
+      }
+
+      for(unsigned v = 0; v < NUM_VOICES; ++v)
+      {
+         ref[v].tick();
+         bank_voice[v].tick();
+      }
+   }
+
+   EXPECT_GT(non_zero, 0);
+}
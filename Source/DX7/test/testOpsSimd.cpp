@@ -0,0 +1,147 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+#include "DX7/OpsSimd.h"
+#include "DX7/OpsAlg6.h"
+
+#include "STB/Test.h"
+
+//! EG with a different attenuation sweep for each instance
+class StepEG
+{
+public:
+   StepEG() = default;
+
+   void setStep(uint32_t step_) { step = step_; }
+
+   uint32_t getAtten12()
+   {
+      atten12 = (atten12 + step) & 0xFFF;
+      return atten12;
+   }
+
+   void getAtten12(uint32_t* out_, unsigned n_, unsigned stride_)
+   {
+      for(unsigned i = 0; i < n_; ++i)
+         out_[i * stride_] = getAtten12();
+   }
+
+   uint32_t getMinAtten12(unsigned) const { return 0; }
+
+   void skip(unsigned n_)
+   {
+      atten12 = (atten12 + step * n_) & 0xFFF;
+   }
+
+private:
+   uint32_t atten12{0x000};
+   uint32_t step{1};
+};
+
+using TestOps = DX::OpsAlg6<StepEG>;
+
+static void setup(TestOps& ops_, uint8_t alg_, unsigned voice_)
+{
+   ops_.setOpsAlg(alg_);
+   ops_.setOpsFdbk(voice_ % 8);
+   ops_.setOpsSync(true);
+
+   for(unsigned i = 0; i < 6; ++i)
+   {
+      ops_.setOpsFreq(i, 0x0C00 + voice_ * 0x97 + i * 0x123);
+      ops_.getEgPointer(i)->setStep(1 + (voice_ + i) % 5);
+   }
+
+   ops_.keyOn();
+}
+
+
+TEST(OpsSimd, render)
+{
+   static const unsigned NUM_VOICES = 21;
+   static const unsigned BLOCK      = 130;
+
+   DX::OpsSimd::Isa best = DX::OpsSimd::detect();
+
+   for(unsigned isa = DX::OpsSimd::SCALAR; isa <= best; ++isa)
+   {
+      DX::OpsSimd::setIsa(DX::OpsSimd::Isa(isa));
+
+      EXPECT_EQ(isa, DX::OpsSimd::getIsa());
+
+      // Exercise several algorithms at once with uneven group sizes
+      TestOps  ref[NUM_VOICES];
+      TestOps  simd[NUM_VOICES];
+      TestOps* simd_ptr[NUM_VOICES];
+
+      for(unsigned v = 0; v < NUM_VOICES; ++v)
+      {
+         uint8_t alg = ((v * 5) % 3 + (v % 11) * 3) % 32;
+
+         setup(ref[v], alg, v);
+         setup(simd[v], alg, v);
+
+         simd_ptr[v] = &simd[v];
+      }
+
+      for(unsigned block = 0; block < 50; ++block)
+      {
+         int32_t expected[BLOCK] = {};
+         int32_t actual[BLOCK] = {};
+
+         for(unsigned v = 0; v < NUM_VOICES; ++v)
+            ref[v].render(expected, BLOCK);
+
+         DX::OpsSimd::render(simd_ptr, NUM_VOICES, actual, BLOCK,
+                             [](TestOps* ops) -> TestOps& { return *ops; });
+
+         for(unsigned i = 0; i < BLOCK; ++i)
+         {
+            EXPECT_EQ(expected[i], actual[i]);
+         }
+      }
+   }
+
+   DX::OpsSimd::setIsa(best);
+}
+
+
+TEST(OpsSimd, all_algorithms)
+{
+   static const unsigned NUM_VOICES = 8;
+   static const unsigned BLOCK      = 100;
+
+   for(uint8_t alg = 0; alg < 32; ++alg)
+   {
+      TestOps  ref[NUM_VOICES];
+      TestOps  simd[NUM_VOICES];
+      TestOps* simd_ptr[NUM_VOICES];
+
+      for(unsigned v = 0; v < NUM_VOICES; ++v)
+      {
+         setup(ref[v], alg, v);
+         setup(simd[v], alg, v);
+
+         simd_ptr[v] = &simd[v];
+      }
+
+      for(unsigned block = 0; block < 10; ++block)
+      {
+         int32_t expected[BLOCK] = {};
+         int32_t actual[BLOCK] = {};
+
+         for(unsigned v = 0; v < NUM_VOICES; ++v)
+            ref[v].render(expected, BLOCK);
+
+         DX::OpsSimd::render(simd_ptr, NUM_VOICES, actual, BLOCK,
+                             [](TestOps* ops) -> TestOps& { return *ops; });
+
+         for(unsigned i = 0; i < BLOCK; ++i)
+         {
+            EXPECT_EQ(expected[i], actual[i]);
+         }
+      }
+   }
+}
@@ -0,0 +1,32 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+#include "DX7/OpsTables.h"
+
+#include "STB/Test.h"
+
+TEST(OpsTables, freq32)
+{
+   for(uint32_t f14 = 0; f14 < 0x4000; ++f14)
+   {
+      EXPECT_EQ(DX::OpsTablesFull::freq32(f14), DX::OpsTablesCompact::freq32(f14));
+   }
+}
+
+TEST(OpsTables, logSine14)
+{
+   for(uint32_t phase_12 = 0; phase_12 < 0x1000; ++phase_12)
+   {
+      EXPECT_EQ(DX::OpsTablesFull::logSine14(phase_12), DX::OpsTablesCompact::logSine14(phase_12));
+   }
+}
+
+TEST(OpsTables, exp14)
+{
+   for(uint32_t log_14 = 0; log_14 < 0x4000; ++log_14)
+   {
+      EXPECT_EQ(DX::OpsTablesFull::exp14(log_14), DX::OpsTablesCompact::exp14(log_14));
+   }
+}
@@ -0,0 +1,80 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+#include "DX7/Patch.h"
+#include "DX7/Voice.h"
+
+#include "Table_dx7_rom_1.h"
+
+#include "STB/Test.h"
+
+TEST(Patch, silent)
+{
+   const DX7::Patch& patch = DX7::Patch::silent();
+
+   for(unsigned i = 0; i < SysEx::NUM_OP; ++i)
+   {
+      EXPECT_FALSE(patch.op[i].enable);
+   }
+}
+
+TEST(Patch, activate)
+{
+   SysEx::Voice sysex{table_dx7_rom_1, 0};
+
+   sysex.operator_on = 0b111101;
+
+   DX7::Patch patch{sysex};
+
+   EXPECT_EQ(sysex.alg,       patch.alg);
+   EXPECT_EQ(sysex.feedback,  patch.feedback);
+   EXPECT_EQ(sysex.transpose, patch.transpose);
+   EXPECT_FALSE(patch.op[1].enable);
+   EXPECT_TRUE(patch.op[0].enable);
+
+   for(unsigned i = 0; i < SysEx::NUM_OP; ++i)
+   {
+      EXPECT_EQ((sysex.op[i].eg_amp.rate[0] * 164) >> 8, patch.op[i].eg_rate_6[0]);
+      EXPECT_EQ((8 - sysex.op[i].key_vel_sense) * 0x1E0, patch.op[i].sens);
+   }
+}
+
+TEST(Patch, shared)
+{
+   static const unsigned NUM_VOICES = 4;
+
+   SysEx::Voice sysex{table_dx7_rom_1, 10};
+   DX7::Patch   patch{sysex};
+
+   static DX7::Voice<> voice[NUM_VOICES]{};
+
+   // Every voice plays the one activated patch and sounds the same
+   for(unsigned v = 0; v < NUM_VOICES; ++v)
+   {
+      voice[v].loadProgram(patch);
+      voice[v].noteOn(60, 100);
+   }
+
+   unsigned non_zero = 0;
+
+   for(unsigned tick = 0; tick < 100; ++tick)
+   {
+      for(unsigned v = 0; v < NUM_VOICES; ++v)
+         voice[v].tick();
+
+      for(unsigned i = 0; i < 130; ++i)
+      {
+         int32_t sample = voice[0]();
+
+         for(unsigned v = 1; v < NUM_VOICES; ++v)
+            EXPECT_EQ(sample, voice[v]());
+
+         if (sample != 0)
+            ++non_zero;
+      }
+   }
+
+   EXPECT_GT(non_zero, 0u);
+}
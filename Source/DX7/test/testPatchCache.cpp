@@ -0,0 +1,70 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+#include <cstring>
+
+#include "DX7/PatchCache.h"
+
+#include "Table_dx7_rom_1.h"
+
+#include "STB/Test.h"
+
+static const SysEx::Packed* rom1 = (const SysEx::Packed*)table_dx7_rom_1;
+
+TEST(PatchCache, hit)
+{
+   DX7::PatchCache<4> cache;
+
+   const DX7::Patch& first = cache.find(3, rom1[3]);
+   EXPECT_EQ(0u, cache.hits);
+   EXPECT_EQ(1u, cache.misses);
+
+   const DX7::Patch& again = cache.find(3, rom1[3]);
+   EXPECT_EQ(&first, &again);
+   EXPECT_EQ(1u, cache.hits);
+   EXPECT_EQ(1u, cache.misses);
+
+   // Same activation as an uncached patch
+   SysEx::Voice sysex;
+   sysex = rom1[3];
+   DX7::Patch patch{sysex};
+
+   EXPECT_EQ(0, memcmp(patch.op[0].kbd_scaling, first.op[0].kbd_scaling, 43));
+   EXPECT_EQ(patch.op[5].pitch_ratio_16, first.op[5].pitch_ratio_16);
+   EXPECT_EQ(patch.lfo.phase_inc, first.lfo.phase_inc);
+}
+
+TEST(PatchCache, lru)
+{
+   DX7::PatchCache<2> cache;
+
+   const DX7::Patch* p0 = &cache.find(0, rom1[0]);
+   const DX7::Patch* p1 = &cache.find(1, rom1[1]);
+
+   // Use 0 so that 1 is the least recently used
+   EXPECT_EQ(p0, &cache.find(0, rom1[0]));
+
+   const DX7::Patch* p2 = &cache.find(2, rom1[2]);
+   EXPECT_EQ(p1, p2);
+   EXPECT_EQ(3u, cache.misses);
+
+   EXPECT_EQ(p0, &cache.find(0, rom1[0]));
+   EXPECT_EQ(2u, cache.hits);
+}
+
+TEST(PatchCache, content_change)
+{
+   DX7::PatchCache<4> cache;
+
+   SysEx::Packed packed = rom1[7];
+
+   cache.find(7, packed);
+
+   // A new bank loaded into the same program misses
+   packed.alg ^= 1;
+   const DX7::Patch& patch = cache.find(7, packed);
+   EXPECT_EQ(2u, cache.misses);
+   EXPECT_EQ(packed.alg, patch.alg);
+}
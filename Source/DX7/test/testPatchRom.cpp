@@ -0,0 +1,79 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+#include "DX7/Patch.h"
+
+#include "Table_dx7_rom_1.h"
+#include "Table_dx7_rom_2.h"
+#include "Table_dx7_rom_3.h"
+#include "Table_dx7_rom_4.h"
+#include "Table_dx7_patch_1.h"
+#include "Table_dx7_patch_2.h"
+#include "Table_dx7_patch_3.h"
+#include "Table_dx7_patch_4.h"
+
+#include "STB/Test.h"
+
+//! Check the patches activated at build time match run-time activation
+static void checkRom(const uint8_t* rom_, const uint8_t* image_)
+{
+   for(unsigned index = 0; index < 32; ++index)
+   {
+      SysEx::Voice sysex{rom_, index};
+      DX7::Patch   expected{sysex};
+      DX7::Patch   actual;
+
+      actual.load(image_ + index * DX7::Patch::IMAGE_SIZE);
+
+      for(unsigned i = 0; i < SysEx::NUM_OP; ++i)
+      {
+         const DX7::Patch::Op& exp = expected.op[i];
+         const DX7::Patch::Op& act = actual.op[i];
+
+         for(unsigned j = 0; j < 4; ++j)
+         {
+            EXPECT_EQ(exp.eg_rate_6[j],  act.eg_rate_6[j]);
+            EXPECT_EQ(exp.eg_atten_6[j], act.eg_atten_6[j]);
+         }
+
+         EXPECT_EQ(exp.pitch_ratio_16, act.pitch_ratio_16);
+         EXPECT_EQ(exp.pitch_fixed,    act.pitch_fixed);
+         EXPECT_EQ(exp.detune,         act.detune);
+         EXPECT_EQ(exp.rate_scale,     act.rate_scale);
+         EXPECT_EQ(exp.amp_mod_sens,   act.amp_mod_sens);
+         EXPECT_EQ(exp.enable,         act.enable);
+         EXPECT_EQ(exp.sens,           act.sens);
+
+         for(unsigned j = 0; j < 43; ++j)
+         {
+            EXPECT_EQ(exp.kbd_scaling[j], act.kbd_scaling[j]);
+         }
+      }
+
+      EXPECT_EQ(expected.alg,       actual.alg);
+      EXPECT_EQ(expected.feedback,  actual.feedback);
+      EXPECT_EQ(expected.osc_sync,  actual.osc_sync);
+      EXPECT_EQ(expected.transpose, actual.transpose);
+
+      EXPECT_EQ(expected.lfo.phase_inc,       actual.lfo.phase_inc);
+      EXPECT_EQ(expected.lfo.delay_inc,       actual.lfo.delay_inc);
+      EXPECT_EQ(expected.lfo.waveform,        actual.lfo.waveform);
+      EXPECT_EQ(expected.lfo.amp_mod_depth,   actual.lfo.amp_mod_depth);
+      EXPECT_EQ(expected.lfo.pitch_mod_depth, actual.lfo.pitch_mod_depth);
+      EXPECT_EQ(expected.lfo.pitch_mod_sense, actual.lfo.pitch_mod_sense);
+      EXPECT_EQ(expected.lfo.sync,            actual.lfo.sync);
+
+      for(unsigned j = 0; j < 4; ++j)
+      {
+         EXPECT_EQ(expected.pitch_eg.rate[j],  actual.pitch_eg.rate[j]);
+         EXPECT_EQ(expected.pitch_eg.level[j], actual.pitch_eg.level[j]);
+      }
+   }
+}
+
+TEST(PatchRom, rom_1) { checkRom(table_dx7_rom_1, table_dx7_patch_1); }
+TEST(PatchRom, rom_2) { checkRom(table_dx7_rom_2, table_dx7_patch_2); }
+TEST(PatchRom, rom_3) { checkRom(table_dx7_rom_3, table_dx7_patch_3); }
+TEST(PatchRom, rom_4) { checkRom(table_dx7_rom_4, table_dx7_patch_4); }
@@ -74,3 +74,21 @@ TEST(PitchEg, flat)
 
    fclose(fp);
 }
+
+TEST(PitchEg, idle)
+{
+   PitchEg<1>   pitch_eg;
+   SysEx::Voice patch;
+
+   patch.eg_pitch.level[3] = 99;
+
+   pitch_eg.load(patch);
+
+   // No pitch offset until the first key on, whatever the patch
+   for(unsigned t = 0; t < 10; ++t)
+   {
+      pitch_eg.tick();
+
+      EXPECT_EQ(0, pitch_eg.getOutput(0));
+   }
+}
@@ -0,0 +1,138 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+#include "RenderPool.h"
+#include "VoicePartition.h"
+
+#include "DX7/Synth.h"
+
+#include "TestVoices.h"
+
+#include "STB/Test.h"
+
+static const unsigned NUM_VOICES = 32;
+static const unsigned NUM_TICKS  = 40;
+static const unsigned BLOCK      = 130;
+
+//! Render with the voices partitioned between the workers of a pool
+static void render(unsigned     num_workers_,
+                   DX7::Voice<> (&voice_)[NUM_VOICES],
+                   int32_t      (&out_)[NUM_TICKS][BLOCK])
+{
+   TestVoices::start(voice_, /* first_note */ 36);
+
+   RenderPool pool{num_workers_};
+
+   VoicePartition<NUM_VOICES, RenderPool::MAX_WORKERS> partition;
+
+   uint32_t active = 0xFFFFFFFF;
+
+   for(unsigned tick = 0; tick < NUM_TICKS; ++tick)
+   {
+      partition.assign(&active, pool.getNumWorkers(),
+                       [&voice_](unsigned index_) { return voice_[index_].getRenderCost(); });
+
+      pool.mix(out_[tick], BLOCK,
+               [&partition, &voice_](unsigned worker_, int32_t* buffer_, unsigned n_)
+               {
+                  DX7::Voice<>* item[NUM_VOICES];
+                  unsigned      count = 0;
+
+                  for(unsigned v = 0; v < NUM_VOICES; ++v)
+                  {
+                     if ((partition.getMask(worker_)[0] >> v) & 1)
+                        item[count++] = &voice_[v];
+                  }
+
+                  for(unsigned i = 0; i < n_; ++i)
+                     buffer_[i] = 0;
+
+                  DX7::Voice<>::render(item, count, buffer_, n_);
+               });
+
+      for(unsigned v = 0; v < NUM_VOICES; ++v)
+         voice_[v].tick();
+   }
+}
+
+TEST(RenderPool, workers)
+{
+   RenderPool pool0{0};
+   EXPECT_EQ(1u, pool0.getNumWorkers());
+
+   RenderPool pool3{3};
+   EXPECT_EQ(3u, pool3.getNumWorkers());
+
+   RenderPool pool_max{RenderPool::MAX_WORKERS + 1};
+   EXPECT_EQ(RenderPool::MAX_WORKERS, pool_max.getNumWorkers());
+}
+
+TEST(RenderPool, bit_exact)
+{
+   static const unsigned num_workers[] = {2, 3, 4, 8};
+
+   // Fresh voices for each render
+   static DX7::Voice<> voice[1 + 4][NUM_VOICES]{};
+
+   static int32_t ref[NUM_TICKS][BLOCK];
+   static int32_t out[NUM_TICKS][BLOCK];
+
+   render(1, voice[0], ref);
+
+   for(unsigned i = 0; i < 4; ++i)
+   {
+      render(num_workers[i], voice[1 + i], out);
+
+      for(unsigned tick = 0; tick < NUM_TICKS; ++tick)
+      {
+         for(unsigned j = 0; j < BLOCK; ++j)
+            EXPECT_EQ(ref[tick][j], out[tick][j]);
+      }
+   }
+}
+
+TEST(RenderPool, by_voice)
+{
+   static const unsigned DAC_FREQ = 49096;
+   static const unsigned N        = 4096;
+
+   using Synth = DX7::Synth<16, /* AMP_N */ 4>;
+
+   // Same performance rendered a block at a time and voice by voice
+   static Synth synth[2];
+
+   static int32_t ref[N];
+   static int32_t out[N];
+   static int32_t scratch[3 * N];
+
+   RenderPool pool{3};
+
+   for(auto& s : synth)
+   {
+      s.init();
+      s.setTickRate(DAC_FREQ, /* tick_rate */ 375);
+      s.programChange(0, 10);
+
+      for(unsigned i = 0; i < 12; ++i)
+      {
+         s.setEventTime(i * 300);
+         s.noteOn(48 + i * 3, 100);
+
+         if (i == 6)
+            s.controlChange(1, 127);
+      }
+   }
+
+   for(unsigned block = 0; block < 8; ++block)
+   {
+      synth[0].render(ref, N);
+      synth[1].renderByVoice(pool, out, N, scratch);
+
+      for(unsigned i = 0; i < N; ++i)
+         EXPECT_EQ(ref[i], out[i]);
+   }
+
+   EXPECT_NE(0, ref[N - 1]);
+}
@@ -0,0 +1,175 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+#include <vector>
+
+#include "Snapshot.h"
+
+#include "DX7/Synth.h"
+
+#include "STB/Test.h"
+
+static const unsigned DAC_FREQ = 49096;
+static const unsigned BLOCK    = 1000;
+
+using TestSynth = DX7::Synth<16, /* AMP_N */ 4>;
+
+struct Fields
+{
+   template <typename SNAPSHOT>
+   void snapshot(SNAPSHOT& s_)
+   {
+      s_.field(a);
+      s_.field(b);
+      s_.field(c);
+   }
+
+   uint8_t  a{0};
+   uint32_t b{0};
+   int16_t  c[3]{};
+};
+
+//! Start a performance with events queued beyond the first blocks
+static void play(TestSynth& synth_)
+{
+   synth_.init();
+   synth_.setTickRate(DAC_FREQ, /* tick_rate */ 375);
+   synth_.programChange(0, 0);
+
+   for(unsigned i = 0; i < 10; ++i)
+   {
+      synth_.setEventTime(i * 700);
+      synth_.noteOn(40 + i * 5, 60 + i * 6);
+
+      if (i == 4)
+      {
+         synth_.controlChange(1, 100);
+         synth_.pitchBend(0x600);
+      }
+
+      if (i >= 6)
+         synth_.noteOff(40 + (i - 6) * 5, 0);
+   }
+}
+
+TEST(Snapshot, fields)
+{
+   Fields in;
+
+   in.a    = 0x12;
+   in.b    = 0x3456789A;
+   in.c[0] = -1;
+   in.c[2] = 0x7BCD;
+
+   Snapshot::Writer counter;
+   in.snapshot(counter);
+   EXPECT_EQ(11u, counter.size());
+
+   uint8_t buffer[11];
+
+   Snapshot::Writer writer{buffer, sizeof(buffer)};
+   in.snapshot(writer);
+   EXPECT_TRUE(writer.ok());
+
+   Fields out;
+
+   Snapshot::Reader reader{buffer, sizeof(buffer)};
+   out.snapshot(reader);
+   EXPECT_TRUE(reader.ok());
+   EXPECT_EQ(0u, reader.remaining());
+
+   EXPECT_EQ(in.a, out.a);
+   EXPECT_EQ(in.b, out.b);
+   EXPECT_EQ(in.c[0], out.c[0]);
+   EXPECT_EQ(in.c[1], out.c[1]);
+   EXPECT_EQ(in.c[2], out.c[2]);
+
+   // Buffers too small
+   Snapshot::Writer short_writer{buffer, sizeof(buffer) - 1};
+   in.snapshot(short_writer);
+   EXPECT_FALSE(short_writer.ok());
+
+   Snapshot::Reader short_reader{buffer, sizeof(buffer) - 1};
+   out.snapshot(short_reader);
+   EXPECT_FALSE(short_reader.ok());
+}
+
+TEST(Snapshot, save_restore)
+{
+   Fields in;
+   in.b = 42;
+
+   uint8_t buffer[64];
+   size_t  size = Snapshot::save(in, /* id */ 7, buffer, sizeof(buffer));
+
+   EXPECT_EQ(Snapshot::size(in), size);
+
+   Fields out;
+
+   EXPECT_FALSE(Snapshot::restore(out, /* id */ 8, buffer, size));
+   EXPECT_FALSE(Snapshot::restore(out, /* id */ 7, buffer, size - 1));
+
+   buffer[size - 1] ^= 1;
+   EXPECT_FALSE(Snapshot::restore(out, /* id */ 7, buffer, size));
+   EXPECT_EQ(0u, out.b);
+
+   buffer[size - 1] ^= 1;
+   EXPECT_TRUE(Snapshot::restore(out, /* id */ 7, buffer, size));
+   EXPECT_EQ(42u, out.b);
+
+   EXPECT_EQ(0u, Snapshot::save(in, /* id */ 7, buffer, size - 1));
+}
+
+TEST(Snapshot, synth_resume)
+{
+   // A performance saved part way through and resumed in a synth that
+   // was never initialised
+   static TestSynth synth;
+   static TestSynth resumed;
+
+   static int32_t ref[BLOCK];
+   static int32_t out[BLOCK];
+
+   play(synth);
+
+   for(unsigned block = 0; block < 3; ++block)
+      synth.render(ref, BLOCK);
+
+   std::vector<uint8_t> state(synth.getStateSize());
+
+   EXPECT_EQ(state.size(), synth.saveState(state.data(), state.size()));
+   EXPECT_TRUE(resumed.restoreState(state.data(), state.size()));
+
+   for(unsigned block = 0; block < 20; ++block)
+   {
+      synth.render(ref, BLOCK);
+      resumed.render(out, BLOCK);
+
+      for(unsigned i = 0; i < BLOCK; ++i)
+         EXPECT_EQ(ref[i], out[i]);
+   }
+
+   EXPECT_NE(0, ref[BLOCK - 1]);
+}
+
+TEST(Snapshot, synth_reject)
+{
+   static TestSynth synth;
+
+   play(synth);
+
+   std::vector<uint8_t> state(synth.getStateSize());
+
+   EXPECT_EQ(0u, synth.saveState(state.data(), state.size() - 1));
+   EXPECT_EQ(state.size(), synth.saveState(state.data(), state.size()));
+
+   // Different configuration
+   static DX7::Synth<8> other;
+   EXPECT_FALSE(other.restoreState(state.data(), state.size()));
+
+   // Damaged
+   state[state.size() / 2] ^= 0x80;
+   EXPECT_FALSE(synth.restoreState(state.data(), state.size()));
+}
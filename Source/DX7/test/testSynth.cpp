@@ -0,0 +1,88 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+#include <vector>
+
+#include "DX7/Synth.h"
+
+#include "Table_dx7_rom_2.h"
+
+#include "STB/Test.h"
+
+static const unsigned DAC_FREQ   = 49096;
+static const unsigned BLOCK      = 256;
+static const unsigned NUM_BLOCKS = 20;
+
+using TestSynth = DX7::Synth<16, /* AMP_N */ 4>;
+
+//! 32 voice bulk dump of a cartridge image as sent over MIDI
+static std::vector<uint8_t> bulkDump(const uint8_t* cartridge_)
+{
+   std::vector<uint8_t> dump{0xF0, 0x43, 0x00, 0x09, 0x20, 0x00};
+
+   uint8_t sum = 0;
+
+   for(unsigned i = 0; i < 4096; ++i)
+   {
+      dump.push_back(cartridge_[i]);
+      sum += cartridge_[i];
+   }
+
+   dump.push_back(-sum & 0x7F);
+   dump.push_back(0xF7);
+
+   return dump;
+}
+
+static void start(TestSynth& synth_)
+{
+   synth_.init();
+   synth_.setTickRate(DAC_FREQ, /* tick_rate */ 375);
+}
+
+TEST(Synth, sysex_bulk_dump)
+{
+   static TestSynth loaded;
+   static TestSynth rom;
+
+   static int32_t ref[BLOCK];
+   static int32_t out[BLOCK];
+
+   std::vector<uint8_t> dump = bulkDump(table_dx7_rom_2);
+
+   EXPECT_EQ(4104u, dump.size());
+
+   // The whole dump arrives between two blocks
+   start(loaded);
+   loaded.render(out, BLOCK);
+
+   for(uint8_t byte : dump)
+      loaded.sysEx(byte);
+
+   loaded.render(out, BLOCK);
+
+   EXPECT_EQ(0u, loaded.getDroppedEvents());
+
+   // Program 6 of the loaded bank plays as program 6 of ROM 2
+   loaded.programChange(0, 5);
+   loaded.noteOn(60, 100);
+
+   start(rom);
+   rom.render(ref, BLOCK);
+   rom.render(ref, BLOCK);
+   rom.programChange(0, 32 + 5);
+   rom.noteOn(60, 100);
+
+   for(unsigned block = 0; block < NUM_BLOCKS; ++block)
+   {
+      rom.render(ref, BLOCK);
+      loaded.render(out, BLOCK);
+
+      for(unsigned i = 0; i < BLOCK; ++i)
+         EXPECT_EQ(ref[i], out[i]);
+   }
+
+   EXPECT_NE(0, ref[BLOCK - 1]);
+}
@@ -0,0 +1,73 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+#include "TickScheduler.h"
+
+#include "STB/Test.h"
+
+static const unsigned SAMPLE_RATE = 49096;
+static const unsigned TICK_RATE   = 375;
+
+//! Run for one second in blocks of block_ samples, recording the sample
+//! at which each tick fires
+static unsigned run(unsigned block_, uint32_t* tick_sample_)
+{
+   TickScheduler scheduler{SAMPLE_RATE, TICK_RATE};
+
+   unsigned num_ticks = 0;
+
+   for(unsigned start = 0; start < SAMPLE_RATE; start += block_)
+   {
+      unsigned end = start + block_ < SAMPLE_RATE ? start + block_ : SAMPLE_RATE;
+
+      for(unsigned offset = start; offset < end; )
+      {
+         unsigned len = scheduler.samplesToTick(end - offset);
+
+         offset += len;
+
+         if (scheduler.advance(len))
+            tick_sample_[num_ticks++] = offset;
+      }
+   }
+
+   return num_ticks;
+}
+
+TEST(TickScheduler, rate)
+{
+   static const unsigned block[] = {1, 64, 130, 131, 2048, 4096};
+
+   static uint32_t ref[TICK_RATE + 1];
+   static uint32_t tick_sample[TICK_RATE + 1];
+
+   EXPECT_EQ(TICK_RATE, run(SAMPLE_RATE, ref));
+
+   for(unsigned b : block)
+   {
+      EXPECT_EQ(TICK_RATE, run(b, tick_sample));
+
+      // Ticks fire on the same samples whatever the block size
+      for(unsigned i = 0; i < TICK_RATE; ++i)
+         EXPECT_EQ(ref[i], tick_sample[i]);
+   }
+
+   // Each tick period is the exact period rounded down or up
+   for(unsigned i = 1; i < TICK_RATE; ++i)
+   {
+      uint32_t period = ref[i] - ref[i - 1];
+
+      EXPECT_GE(period, SAMPLE_RATE / TICK_RATE);
+      EXPECT_LE(period, SAMPLE_RATE / TICK_RATE + 1);
+   }
+}
+
+TEST(TickScheduler, disabled)
+{
+   TickScheduler scheduler{};
+
+   EXPECT_EQ(4096u, scheduler.samplesToTick(4096));
+   EXPECT_FALSE(scheduler.advance(4096));
+}
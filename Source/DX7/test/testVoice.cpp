@@ -0,0 +1,77 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+#include "DX7/Patch.h"
+#include "DX7/Voice.h"
+
+#include "Table_dx7_rom_1.h"
+
+#include "STB/Test.h"
+
+static void run(DX7::Voice<>& voice_, unsigned ticks_)
+{
+   for(unsigned tick = 0; tick < ticks_; ++tick)
+   {
+      voice_.tick();
+
+      for(unsigned i = 0; i < 130; ++i)
+         (void) voice_();
+   }
+}
+
+TEST(Voice, steal_cost)
+{
+   DX7::Patch patch{SysEx::Voice{table_dx7_rom_1, 10}};
+
+   static DX7::Voice<> held{};
+   static DX7::Voice<> released{};
+   static DX7::Voice<> muted{};
+
+   EXPECT_EQ(0u, muted.getStealCost());
+
+   held.loadProgram(patch);
+   held.noteOn(60, 100);
+
+   released.loadProgram(patch);
+   released.noteOn(60, 100);
+
+   run(held,     50);
+   run(released, 50);
+
+   EXPECT_EQ(held.getStealCost(), released.getStealCost());
+
+   released.noteOff(0);
+
+   uint32_t release_cost = released.getStealCost();
+
+   EXPECT_GT(release_cost, 0u);
+   EXPECT_LT(release_cost, held.getStealCost());
+
+   // A released voice gets cheaper as it fades
+   run(released, 50);
+
+   EXPECT_LT(released.getStealCost(), release_cost);
+   EXPECT_LT(released.getStealCost(), held.getStealCost());
+}
+
+TEST(Voice, carrier_atten)
+{
+   // No note, all carriers at full attenuation
+   Egs<> egs{};
+
+   EXPECT_EQ(0xFFFu, egs.getCarrierAtten12());
+
+   // A held note costs more than any released note
+   static DX7::Voice<> voice{};
+
+   DX7::Patch patch{SysEx::Voice{table_dx7_rom_1, 0}};
+
+   voice.loadProgram(patch);
+   voice.noteOn(60, 127);
+
+   run(voice, 10);
+
+   EXPECT_GT(voice.getStealCost(), 0x1000u);
+}
@@ -0,0 +1,153 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+#include <thread>
+
+#include "VoicePartition.h"
+
+#include "TestVoices.h"
+
+#include "STB/Test.h"
+
+static const unsigned NUM_VOICES = 16;
+
+static DX7::Voice<> voice[NUM_VOICES]{};
+
+static uint32_t cost(unsigned index_)
+{
+   return voice[index_].getRenderCost();
+}
+
+TEST(VoicePartition, skewed)
+{
+   // All the notes are on the voices a fixed split gives to the first core
+   uint32_t active = 0x00FF;
+
+   TestVoices::start(voice, /* first_note */ 48, active);
+
+   VoicePartition<NUM_VOICES, /* MAX_WORKERS */ 4> partition;
+
+   partition.assign(&active, 2, cost);
+
+   uint32_t max_cost = 0;
+   uint32_t total    = 0;
+
+   for(unsigned v = 0; v < NUM_VOICES; ++v)
+   {
+      uint32_t c = cost(v);
+
+      total += c;
+      if (c > max_cost)
+         max_cost = c;
+   }
+
+   uint32_t load0 = partition.getLoad(0);
+   uint32_t load1 = partition.getLoad(1);
+
+   EXPECT_EQ(total, load0 + load1);
+   EXPECT_LE(load0 > load1 ? load0 - load1 : load1 - load0, max_cost);
+
+   // Every sounding voice is assigned to exactly one worker
+   EXPECT_EQ(active, partition.getMask(0)[0] | partition.getMask(1)[0]);
+   EXPECT_EQ(0u, partition.getMask(0)[0] & partition.getMask(1)[0]);
+}
+
+TEST(VoicePartition, workers)
+{
+   uint32_t active = 0xF00F;
+
+   TestVoices::start(voice, /* first_note */ 48, active);
+
+   VoicePartition<NUM_VOICES, /* MAX_WORKERS */ 4> partition;
+
+   // Clamped to the supported number of workers
+   partition.assign(&active, 8, cost);
+   EXPECT_EQ(4u, partition.getNumWorkers());
+
+   uint32_t mask = 0;
+
+   for(unsigned w = 0; w < 4; ++w)
+   {
+      EXPECT_GT(partition.getLoad(w), 0u);
+      mask |= partition.getMask(w)[0];
+   }
+
+   EXPECT_EQ(active, mask);
+
+   partition.assign(&active, 0, cost);
+   EXPECT_EQ(1u, partition.getNumWorkers());
+   EXPECT_EQ(active, partition.getMask(0)[0]);
+}
+
+TEST(VoicePartition, threads)
+{
+   static const unsigned NUM_TICKS = 50;
+   static const unsigned BLOCK     = 130;
+
+   static DX7::Voice<> ref_voice[NUM_VOICES]{};
+   static DX7::Voice<> thread_voice[NUM_VOICES]{};
+
+   uint32_t active = 0x0F0F;
+
+   // Reference, all voices rendered on this thread
+   TestVoices::start(ref_voice, /* first_note */ 48, active);
+
+   int32_t ref[NUM_TICKS][BLOCK] = {};
+
+   for(unsigned tick = 0; tick < NUM_TICKS; ++tick)
+   {
+      for(unsigned v = 0; v < NUM_VOICES; ++v)
+      {
+         if (ref_voice[v].isMute())
+            continue;
+
+         for(unsigned i = 0; i < BLOCK; ++i)
+            ref[tick][i] += ref_voice[v]();
+
+         ref_voice[v].tick();
+      }
+   }
+
+   // Same notes with the voices partitioned between two threads each tick
+   TestVoices::start(thread_voice, /* first_note */ 48, active);
+
+   VoicePartition<NUM_VOICES, /* MAX_WORKERS */ 2> partition;
+
+   auto thread_cost = [](unsigned index_)
+   {
+      return thread_voice[index_].getRenderCost();
+   };
+
+   auto worker = [&partition](unsigned worker_, int32_t* out_)
+   {
+      for(unsigned v = 0; v < NUM_VOICES; ++v)
+      {
+         if (((partition.getMask(worker_)[0] >> v) & 1) == 0)
+            continue;
+
+         for(unsigned i = 0; i < BLOCK; ++i)
+            out_[i] += thread_voice[v]();
+
+         thread_voice[v].tick();
+      }
+   };
+
+   for(unsigned tick = 0; tick < NUM_TICKS; ++tick)
+   {
+      partition.assign(&active, 2, thread_cost);
+
+      int32_t out0[BLOCK] = {};
+      int32_t out1[BLOCK] = {};
+
+      std::thread thread{worker, 1, out1};
+
+      worker(0, out0);
+
+      thread.join();
+
+      for(unsigned i = 0; i < BLOCK; ++i)
+         EXPECT_EQ(ref[tick][i], out0[i] + out1[i]);
+   }
+}
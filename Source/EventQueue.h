@@ -0,0 +1,104 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief Lock-free single producer single consumer event queue
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+//! Ring of events passed from one producer thread to one consumer thread.
+//! The producer only writes the tail and the consumer only writes the
+//! head so no locks, or read-modify-write atomics which the Cortex-M0+
+//! does not have, are needed
+template <typename EVENT, unsigned SIZE>
+class EventQueue
+{
+   static_assert((SIZE & (SIZE - 1)) == 0, "SIZE must be a power of 2");
+
+public:
+   EventQueue() = default;
+
+   //! Number of events that the queue can hold
+   static constexpr unsigned capacity() { return SIZE; }
+
+   //! Consumer, true if there are no events waiting
+   bool empty() const
+   {
+      return head.load(std::memory_order_relaxed) == tail.load(std::memory_order_acquire);
+   }
+
+   //! Producer, number of events waiting
+   unsigned size() const
+   {
+      return tail.load(std::memory_order_relaxed) - head.load(std::memory_order_acquire);
+   }
+
+   //! Producer, add an event, returns false if the queue is full
+   bool push(const EVENT& event_)
+   {
+      uint32_t t = tail.load(std::memory_order_relaxed);
+
+      if ((t - head.load(std::memory_order_acquire)) == SIZE)
+         return false;
+
+      ring[t % SIZE] = event_;
+
+      tail.store(t + 1, std::memory_order_release);
+      return true;
+   }
+
+   //! Consumer, oldest event or nullptr if the queue is empty. The event
+   //! remains valid until pop()
+   const EVENT* front() const
+   {
+      uint32_t h = head.load(std::memory_order_relaxed);
+
+      if (h == tail.load(std::memory_order_acquire))
+         return nullptr;
+
+      return &ring[h % SIZE];
+   }
+
+   //! Consumer, remove the oldest event
+   void pop()
+   {
+      uint32_t h = head.load(std::memory_order_relaxed);
+
+      head.store(h + 1, std::memory_order_release);
+   }
+
+   //! Save or restore the waiting events, see Snapshot. Only while
+   //! neither the producer nor the consumer is running
+   template <typename SNAPSHOT>
+   void snapshot(SNAPSHOT& s_)
+   {
+      uint32_t h = head.load(std::memory_order_relaxed);
+      uint32_t t = tail.load(std::memory_order_relaxed);
+
+      s_.field(h);
+      s_.field(t);
+
+      if ((t - h) > SIZE)
+      {
+         s_.fail();
+         return;
+      }
+
+      for(uint32_t i = h; i != t; ++i)
+      {
+         s_.field(ring[i % SIZE]);
+      }
+
+      head.store(h, std::memory_order_relaxed);
+      tail.store(t, std::memory_order_relaxed);
+   }
+
+private:
+   std::atomic<uint32_t> head{0};   //!< Next event to consume
+   std::atomic<uint32_t> tail{0};   //!< Next free slot
+   EVENT                 ring[SIZE];
+};
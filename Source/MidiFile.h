@@ -0,0 +1,326 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief Standard MIDI File reader
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+//! Reader for format 0 and 1 Standard MIDI Files. The channel messages of
+//! all the tracks are merged into one list in time order, with the times
+//! converted from ticks to samples through the tempo map. Meta events
+//! other than tempo and SYSEX are skipped
+class MidiFile
+{
+public:
+   struct Event
+   {
+      uint32_t time;     //!< Sample time
+      uint8_t  status;   //!< Channel message status byte
+      uint8_t  data1;
+      uint8_t  data2;
+   };
+
+   MidiFile() = default;
+
+   //! Channel messages in time order
+   const std::vector<Event>& getEvents() const { return events; }
+
+   //! Sample time of the end of the longest track
+   uint32_t getLength() const { return length; }
+
+   //! Load a file, returns false if it can't be read or is not a
+   //! Standard MIDI File
+   bool load(const char* filename_, unsigned sample_rate_)
+   {
+      FILE* fp = fopen(filename_, "rb");
+      if (fp == nullptr)
+         return false;
+
+      std::vector<uint8_t> image;
+      uint8_t              buffer[4096];
+      size_t               n;
+
+      while((n = fread(buffer, 1, sizeof(buffer), fp)) != 0)
+         image.insert(image.end(), buffer, buffer + n);
+
+      fclose(fp);
+
+      return parse(image.data(), image.size(), sample_rate_);
+   }
+
+   //! Parse a file image, returns false if it is not a Standard MIDI File
+   bool parse(const uint8_t* data_, size_t size_, unsigned sample_rate_)
+   {
+      events.clear();
+      length = 0;
+
+      Reader reader{data_, data_ + size_};
+
+      if (not reader.chunk("MThd") || (reader.chunk_size < 6))
+         return false;
+
+      unsigned format     = reader.u16();
+      unsigned num_tracks = reader.u16();
+      unsigned division   = reader.u16();
+
+      if ((format > 1) || (division == 0))
+         return false;
+
+      reader.skip(reader.chunk_size - 6);
+
+      std::vector<TickEvent> tick_events;
+      uint32_t               end_tick = 0;
+
+      for(unsigned track = 0; track < num_tracks; ++track)
+      {
+         if (not reader.chunk("MTrk"))
+            return false;
+
+         Reader track_reader{reader.ptr, reader.ptr + reader.chunk_size};
+
+         if (not parseTrack(track_reader, tick_events, end_tick))
+            return false;
+
+         reader.skip(reader.chunk_size);
+      }
+
+      // Tracks were appended in order so events at the same tick keep
+      // their track order
+      std::stable_sort(tick_events.begin(), tick_events.end(),
+                       [](const TickEvent& a, const TickEvent& b) { return a.tick < b.tick; });
+
+      TempoMap tempo{division, sample_rate_};
+
+      for(const auto& e : tick_events)
+      {
+         if (e.status == STATUS_TEMPO)
+            tempo.setTempo(e.tick, e.tempo);
+         else
+            events.push_back(Event{tempo.toSample(e.tick), e.status, e.data1, e.data2});
+      }
+
+      length = tempo.toSample(end_tick);
+
+      return true;
+   }
+
+private:
+   static const uint8_t STATUS_TEMPO = 0xFF;   //!< Set tempo meta event
+
+   //! Event with the time still in ticks
+   struct TickEvent
+   {
+      uint32_t tick;
+      uint32_t tempo;    //!< uS per quarter note for STATUS_TEMPO
+      uint8_t  status;
+      uint8_t  data1;
+      uint8_t  data2;
+   };
+
+   //! Bounds checked big-endian reader
+   struct Reader
+   {
+      const uint8_t* ptr;
+      const uint8_t* end;
+      uint32_t       chunk_size{0};
+      bool           ok{true};
+
+      bool atEnd() const { return (ptr >= end) || not ok; }
+
+      uint8_t u8()
+      {
+         if (ptr >= end)
+         {
+            ok = false;
+            return 0;
+         }
+
+         return *ptr++;
+      }
+
+      uint16_t u16() { uint16_t value = u8() << 8; return value | u8(); }
+      uint32_t u32() { uint32_t value = u16() << 16; return value | u16(); }
+
+      //! Variable length quantity
+      uint32_t vlq()
+      {
+         uint32_t value = 0;
+
+         for(unsigned i = 0; i < 4; ++i)
+         {
+            uint8_t byte = u8();
+
+            value = (value << 7) | (byte & 0x7F);
+
+            if ((byte & 0x80) == 0)
+               break;
+         }
+
+         return value;
+      }
+
+      void skip(uint32_t n_)
+      {
+         if (n_ > uint32_t(end - ptr))
+         {
+            ok  = false;
+            ptr = end;
+         }
+         else
+         {
+            ptr += n_;
+         }
+      }
+
+      //! Read a chunk header, returns false if the type does not match
+      bool chunk(const char* type_)
+      {
+         for(unsigned i = 0; i < 4; ++i)
+         {
+            if (u8() != uint8_t(type_[i]))
+               return false;
+         }
+
+         chunk_size = u32();
+
+         return ok && (chunk_size <= uint32_t(end - ptr));
+      }
+   };
+
+   //! Conversion from ticks to samples for a piecewise constant tempo
+   class TempoMap
+   {
+   public:
+      TempoMap(unsigned division_, unsigned sample_rate_)
+         : sample_rate(sample_rate_)
+      {
+         if (division_ & 0x8000)
+         {
+            // SMPTE frames per second x ticks per frame, tempo is ignored
+            unsigned fps = 0x100 - (division_ >> 8);
+
+            ticks_per_second = fps * (division_ & 0xFF);
+         }
+         else
+         {
+            ticks_per_quarter = division_;
+         }
+      }
+
+      void setTempo(uint32_t tick_, uint32_t tempo_)
+      {
+         if (ticks_per_quarter == 0)
+            return;
+
+         base_sample = toSample(tick_);
+         base_tick   = tick_;
+         tempo       = tempo_;
+      }
+
+      uint32_t toSample(uint32_t tick_) const
+      {
+         uint64_t ticks = tick_ - base_tick;
+         uint64_t den;
+         uint64_t num;
+
+         if (ticks_per_quarter != 0)
+         {
+            num = ticks * tempo * sample_rate;
+            den = uint64_t(ticks_per_quarter) * 1000000;
+         }
+         else
+         {
+            num = ticks * sample_rate;
+            den = ticks_per_second;
+         }
+
+         return base_sample + uint32_t((num + den / 2) / den);
+      }
+
+   private:
+      uint32_t sample_rate;
+      uint32_t ticks_per_quarter{0};
+      uint32_t ticks_per_second{0};
+      uint32_t tempo{500000};          //!< uS per quarter note, default 120 bpm
+      uint32_t base_tick{0};
+      uint32_t base_sample{0};
+   };
+
+   static bool parseTrack(Reader& reader_, std::vector<TickEvent>& events_, uint32_t& end_tick_)
+   {
+      uint32_t tick    = 0;
+      uint8_t  running = 0;
+
+      while(not reader_.atEnd())
+      {
+         tick += reader_.vlq();
+
+         uint8_t byte = reader_.u8();
+
+         if (byte == 0xFF)
+         {
+            // Meta event
+            uint8_t  type = reader_.u8();
+            uint32_t size = reader_.vlq();
+
+            if ((type == 0x51) && (size == 3))
+            {
+               uint32_t tempo = reader_.u8() << 16;
+               tempo |= reader_.u16();
+
+               events_.push_back(TickEvent{tick, tempo, STATUS_TEMPO, 0, 0});
+            }
+            else
+            {
+               reader_.skip(size);
+
+               if (type == 0x2F)
+                  break;
+            }
+         }
+         else if ((byte == 0xF0) || (byte == 0xF7))
+         {
+            // SYSEX
+            reader_.skip(reader_.vlq());
+         }
+         else
+         {
+            uint8_t data1;
+
+            if (byte & 0x80)
+            {
+               running = byte;
+               data1   = reader_.u8();
+            }
+            else if (running != 0)
+            {
+               data1 = byte;
+            }
+            else
+            {
+               return false;
+            }
+
+            uint8_t type  = running >> 4;
+            uint8_t data2 = (type == 0xC) || (type == 0xD) ? 0 : reader_.u8();
+
+            events_.push_back(TickEvent{tick, 0, running, data1, data2});
+         }
+      }
+
+      if (tick > end_tick_)
+         end_tick_ = tick;
+
+      return reader_.ok;
+   }
+
+   std::vector<Event> events;
+   uint32_t           length{0};
+};
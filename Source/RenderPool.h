@@ -0,0 +1,185 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief Pool of native render threads
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+//! Native threads that each mix the voices of one render worker. The
+//! calling thread is worker 0 so a pool of one worker has no threads.
+//! A job is handed to the threads by advancing an atomic generation
+//! count and completion is an atomic count, the calling thread takes no
+//! locks. A thread polls for the next job for SPIN_TIME and then parks
+//! on a condition variable, so a pool with nothing to render uses almost
+//! no CPU. The calling thread notifies without the mutex, a parked thread
+//! that misses the notify finds the job when its PARK_TIME wait ends.
+//! Partial mixes are summed in worker order so the result does not
+//! depend on thread timing
+class RenderPool
+{
+public:
+   static const unsigned MAX_WORKERS = 8;
+   static const unsigned MAX_BLOCK   = 256;   //!< Samples per hand-off
+
+   static constexpr std::chrono::microseconds SPIN_TIME{200};  //!< Poll before parking
+   static constexpr std::chrono::microseconds PARK_TIME{1000}; //!< Longest park between polls
+
+   RenderPool(unsigned num_workers_)
+      : num_workers(num_workers_ < 1           ? 1
+                  : num_workers_ > MAX_WORKERS ? MAX_WORKERS
+                                               : num_workers_)
+   {
+      for(unsigned w = 1; w < num_workers; ++w)
+      {
+         thread[w] = std::thread{&RenderPool::threadMain, this, w};
+      }
+   }
+
+   ~RenderPool()
+   {
+      stop.store(true, std::memory_order_relaxed);
+      advance();
+
+      for(unsigned w = 1; w < num_workers; ++w)
+      {
+         thread[w].join();
+      }
+   }
+
+   //! Number of workers, including the calling thread
+   unsigned getNumWorkers() const { return num_workers; }
+
+   //! Call job_(worker) on every worker and return when all the workers
+   //! have finished
+   template <typename JOB>
+   void run(JOB job_)
+   {
+      job_fn  = [](void* ctx_, unsigned worker_)
+                {
+                   (*static_cast<JOB*>(ctx_))(worker_);
+                };
+      job_ctx = &job_;
+
+      done.store(0, std::memory_order_relaxed);
+
+      // Hand the job to the threads
+      advance();
+
+      runJob(0);
+
+      while(done.load(std::memory_order_acquire) != (num_workers - 1))
+      {
+         std::this_thread::yield();
+      }
+
+      job_ctx = nullptr;
+   }
+
+   //! Mix n samples into out_ where mix_(worker, buffer, n) writes the
+   //! partial mix of one worker into a buffer of up to MAX_BLOCK samples.
+   //! Returns when all the workers have finished
+   template <typename MIX>
+   void mix(int32_t* out_, unsigned n_, MIX mix_)
+   {
+      for(unsigned offset = 0; offset < n_; offset += MAX_BLOCK)
+      {
+         unsigned n = n_ - offset < MAX_BLOCK ? n_ - offset : MAX_BLOCK;
+
+         run([this, &mix_, n](unsigned worker_)
+             {
+                mix_(worker_, partial[worker_], n);
+             });
+
+         for(unsigned i = 0; i < n; ++i)
+         {
+            int32_t sum = 0;
+
+            for(unsigned w = 0; w < num_workers; ++w)
+               sum += partial[w][i];
+
+            out_[offset + i] = sum;
+         }
+      }
+   }
+
+private:
+   using JobFn = void (*)(void* ctx_, unsigned worker_);
+
+   void runJob(unsigned worker_)
+   {
+      (*job_fn)(job_ctx, worker_);
+   }
+
+   //! Start a new generation and wake the parked threads
+   void advance()
+   {
+      generation.fetch_add(1, std::memory_order_release);
+
+      wake.notify_all();
+   }
+
+   //! Wait for the generation to move on from seen_ and return it
+   uint32_t waitJob(uint32_t seen_)
+   {
+      using Clock = std::chrono::steady_clock;
+
+      Clock::time_point spin_end = Clock::now() + SPIN_TIME;
+      uint32_t          gen;
+
+      while((gen = generation.load(std::memory_order_acquire)) == seen_)
+      {
+         if (Clock::now() < spin_end)
+         {
+            std::this_thread::yield();
+            continue;
+         }
+
+         std::unique_lock<std::mutex> lock{mutex};
+
+         wake.wait_for(lock, PARK_TIME,
+                       [this, seen_]
+                       {
+                          return generation.load(std::memory_order_acquire) != seen_;
+                       });
+      }
+
+      return gen;
+   }
+
+   void threadMain(unsigned worker_)
+   {
+      uint32_t seen = 0;
+
+      while(true)
+      {
+         seen = waitJob(seen);
+
+         if (stop.load(std::memory_order_relaxed))
+            return;
+
+         runJob(worker_);
+
+         done.fetch_add(1, std::memory_order_release);
+      }
+   }
+
+   const unsigned          num_workers;
+   std::thread             thread[MAX_WORKERS];
+   std::mutex              mutex;   //!< Only taken by parked threads
+   std::condition_variable wake;
+   std::atomic<uint32_t>   generation{0};
+   std::atomic<unsigned>   done{0};
+   std::atomic<bool>       stop{false};
+   JobFn                   job_fn{};
+   void*                   job_ctx{};
+   int32_t                 partial[MAX_WORKERS][MAX_BLOCK];
+};
@@ -0,0 +1,228 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief Binary snapshot of synth state
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+//! Binary image of the state of a synth for checkpoint and resume.
+//!
+//! A class with state to save implements
+//!
+//!    template <typename SNAPSHOT>
+//!    void snapshot(SNAPSHOT& s_)
+//!
+//! calling s_.field() for each member in turn. The same member saves
+//! with a Snapshot::Writer and restores with a Snapshot::Reader so the
+//! two can not disagree about the order of the fields. save() and
+//! restore() add a header to check the snapshot before any state is
+//! changed. Fields are copied
+//! in the native byte order and layout, a snapshot is only restored by a
+//! build of the same version for the same target
+class Snapshot
+{
+public:
+   //! Serialise fields into a buffer. With no buffer only the size
+   //! needed is counted
+   class Writer
+   {
+   public:
+      Writer(uint8_t* buffer_ = nullptr, size_t capacity_ = 0)
+         : buffer(buffer_)
+         , capacity(capacity_)
+      {
+      }
+
+      //! Bytes written, or needed if the buffer was too small
+      size_t size() const { return offset; }
+
+      //! True if every field was written
+      bool ok() const { return good and (offset <= capacity); }
+
+      //! Mark the snapshot as unusable
+      void fail() { good = false; }
+
+      template <typename TYPE>
+      void field(const TYPE& value_)
+      {
+         static_assert(std::is_trivially_copyable<TYPE>::value, "field must be plain data");
+
+         bytes(&value_, sizeof(TYPE));
+      }
+
+      template <typename TYPE, size_t N>
+      void field(const TYPE (&value_)[N])
+      {
+         static_assert(std::is_trivially_copyable<TYPE>::value, "field must be plain data");
+
+         bytes(value_, sizeof(value_));
+      }
+
+   private:
+      void bytes(const void* data_, size_t size_)
+      {
+         if ((buffer != nullptr) && ((offset + size_) <= capacity))
+            memcpy(buffer + offset, data_, size_);
+
+         offset += size_;
+      }
+
+      uint8_t* buffer;
+      size_t   capacity;
+      size_t   offset{0};
+      bool     good{true};
+   };
+
+   //! Restore fields from a buffer written by Writer
+   class Reader
+   {
+   public:
+      Reader(const uint8_t* buffer_, size_t size_)
+         : buffer(buffer_)
+         , end(size_)
+      {
+      }
+
+      //! Bytes not yet read
+      size_t remaining() const { return end - offset; }
+
+      //! True if every field was read
+      bool ok() const { return good; }
+
+      //! Mark the snapshot as unusable
+      void fail() { good = false; }
+
+      template <typename TYPE>
+      void field(TYPE& value_)
+      {
+         static_assert(std::is_trivially_copyable<TYPE>::value, "field must be plain data");
+
+         bytes(&value_, sizeof(TYPE));
+      }
+
+      template <typename TYPE, size_t N>
+      void field(TYPE (&value_)[N])
+      {
+         static_assert(std::is_trivially_copyable<TYPE>::value, "field must be plain data");
+
+         bytes(value_, sizeof(value_));
+      }
+
+   private:
+      void bytes(void* data_, size_t size_)
+      {
+         if ((offset + size_) > end)
+         {
+            good = false;
+            return;
+         }
+
+         memcpy(data_, buffer + offset, size_);
+
+         offset += size_;
+      }
+
+      const uint8_t* buffer;
+      size_t         end;
+      size_t         offset{0};
+      bool           good{true};
+   };
+
+   //! Write a snapshot of object_ into a buffer, returns the size or 0 if
+   //! the buffer is too small or the state can not be saved. id_ identifies
+   //! the version and configuration of the object
+   template <typename OBJECT>
+   static size_t save(OBJECT& object_, uint32_t id_, uint8_t* buffer_, size_t size_)
+   {
+      if (size_ < sizeof(Header))
+         return 0;
+
+      Writer body{buffer_ + sizeof(Header), size_ - sizeof(Header)};
+
+      object_.snapshot(body);
+
+      if (not body.ok())
+         return 0;
+
+      Header header;
+
+      header.magic = MAGIC;
+      header.id    = id_;
+      header.size  = uint32_t(body.size());
+      header.hash  = hash(buffer_ + sizeof(Header), body.size());
+
+      memcpy(buffer_, &header, sizeof(header));
+
+      return sizeof(Header) + body.size();
+   }
+
+   //! Size of a snapshot of the current state of object_ (bytes)
+   template <typename OBJECT>
+   static size_t size(OBJECT& object_)
+   {
+      Writer counter;
+
+      object_.snapshot(counter);
+
+      return sizeof(Header) + counter.size();
+   }
+
+   //! Restore object_ from a snapshot written by save(). Returns false,
+   //! without changing object_, if the snapshot is damaged or was written
+   //! with a different id_
+   template <typename OBJECT>
+   static bool restore(OBJECT& object_, uint32_t id_, const uint8_t* buffer_, size_t size_)
+   {
+      Header header;
+
+      if (size_ < sizeof(Header))
+         return false;
+
+      memcpy(&header, buffer_, sizeof(header));
+
+      const uint8_t* body = buffer_ + sizeof(Header);
+
+      if ((header.magic != MAGIC) ||
+          (header.id != id_) ||
+          (header.size != (size_ - sizeof(Header))) ||
+          (header.hash != hash(body, header.size)))
+         return false;
+
+      Reader reader{body, header.size};
+
+      object_.snapshot(reader);
+
+      return reader.ok() and (reader.remaining() == 0);
+   }
+
+   //! FNV-1a hash of a block of bytes, to detect a damaged snapshot
+   static uint32_t hash(const uint8_t* data_, size_t size_)
+   {
+      uint32_t hash = 0x811C9DC5;
+
+      for(size_t i = 0; i < size_; ++i)
+      {
+         hash = (hash ^ data_[i]) * 0x01000193;
+      }
+
+      return hash;
+   }
+
+private:
+   static const uint32_t MAGIC = 0x53375850;   //!< "PX7S"
+
+   struct Header
+   {
+      uint32_t magic;
+      uint32_t id;     //!< Version and configuration of the saved object
+      uint32_t size;   //!< Bytes following the header
+      uint32_t hash;   //!< Of the bytes following the header
+   };
+};
@@ -33,6 +33,12 @@ public:
       voiceProgram(0, 0);
    }
 
+   //! Apply display changes recorded by the render path, called from
+   //! the main loop before polling getText() and getNumber()
+   virtual void updateDisplay()
+   {
+   }
+
    //! Get display text for the given line if it has been updated
    const char* getText(unsigned line_)
    {
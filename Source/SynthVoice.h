@@ -5,122 +5,965 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 
+#include "EventQueue.h"
 #include "Synth.h"
+#include "TickScheduler.h"
+#include "VoicePartition.h"
 
 template <typename VOICE, unsigned NUM_VOICES, unsigned AMP_N = NUM_VOICES>
 class SynthVoice: public Synth
 {
+   static_assert(NUM_VOICES <= 256, "voice_map entries are 8-bit");
+
 public:
+   static const unsigned MAX_WORKERS = 8;     //!< Most render workers for partition()
+   static const unsigned MAX_EVENTS  = 256;   //!< MIDI events queued for the render path
+   static const unsigned MAX_SYSEX   = 8192;  //!< SYSEX bytes queued, a 32 voice dump is 4104
+
    SynthVoice()
       : Synth(NUM_VOICES)
    {
+      for(unsigned i = 0; i < NUM_VOICES; ++i)
+      {
+         voice[i].setChannel(channel);
+         voice_map[i] = i;
+      }
    }
 
-   //! Get next sample
-   int32_t getSample(unsigned first_voice_= 0,
-                     unsigned num_voices_ = NUM_VOICES)
+   //! Time stamp the events queued from now on with time_ instead of the
+   //! start of the next block. For a producer that schedules events ahead
+   //! of the render, e.g. an offline render, time stamps must not decrease
+   void setEventTime(uint32_t time_)
    {
-      int32_t mix {0};
+      event_time     = time_;
+      event_time_set = true;
+   }
+
+   //! Queue the events of the MIDI messages sent by send_(), for a producer
+   //! on the render thread, e.g. an offline render. Events that do not fit
+   //! in the queue are held until flushEvents(), returns false if any are
+   //! held. The next block must then end at their time stamp so that they
+   //! are queued and applied on time
+   template <typename FN>
+   bool tryQueue(FN send_)
+   {
+      hold_events = true;
+      send_();
+      hold_events = false;
+
+      return num_held == 0;
+   }
+
+   //! Queue the events held by tryQueue(), returns false if the queue is
+   //! still too full for all of them
+   bool flushEvents()
+   {
+      unsigned i = 0;
+
+      while((i < num_held) && event_queue.push(held[i]))
+         ++i;
+
+      for(unsigned j = i; j < num_held; ++j)
+         held[j - i] = held[j];
+
+      num_held -= i;
+
+      return num_held == 0;
+   }
+
+   //! Number of events and SYSEX bytes lost because a queue was full
+   uint32_t getDroppedEvents() const { return dropped_events; }
+
+   //! MIDI::Instrument implementation, public so that SYSEX can also be
+   //! sent directly. The bytes are queued apart from the events and each
+   //! complete message is handed to the render path as one event, so a
+   //! whole bulk dump can arrive between two blocks
+   void sysEx(uint8_t byte_) override final
+   {
+      if (sysex_queue.push(byte_))
+      {
+         ++sysex_tail;
+
+         if (byte_ != 0xF7)
+            return;
+      }
+      else
+      {
+         // The message does not fit, pass on what there is
+         ++dropped_events;
+      }
+
+      queueEvent(EVENT_SYSEX, 0, uint8_t(sysex_tail), uint8_t(sysex_tail >> 8));
+   }
+
+   //! Fire the control tick from render() every sample_rate_ / tick_rate_
+   //! samples, within and across blocks of any size. Until this is called
+   //! render() leaves the control tick to the caller
+   void setTickRate(unsigned sample_rate_, unsigned tick_rate_)
+   {
+      tick_scheduler = TickScheduler{sample_rate_, tick_rate_};
+   }
+
+   //! Sample time of the start of the next block
+   uint32_t getTime() const { return clock.load(std::memory_order_relaxed); }
+
+   //! Apply the MIDI events due before the end of the next block of n_
+   //! samples. Called by the render path at the start of each block,
+   //! before partition() and rendering, so voice state is only changed
+   //! by the render path
+   void processEvents(unsigned n_)
+   {
+      uint32_t start = clock.load(std::memory_order_relaxed);
+
+      applyEvents(start + n_ - 1, /* max */ 1);
+
+      clock.store(start + n_, std::memory_order_relaxed);
+   }
+
+   //! Render the next block of n_ samples applying each queued event on
+   //! the sample of its time stamp. The block is split at the events and
+   //! at the control ticks scheduled by setTickRate(), so the control tick
+   //! cadence does not depend on the events or the block size
+   void render(int32_t* buffer_, unsigned n_)
+   {
+      renderEvents(n_,
+                   [this, buffer_](unsigned offset_, unsigned len_)
+                   {
+                      mixSamples(active_mask, buffer_ + offset_, len_, 0, NUM_VOICES);
+                   });
+   }
+
+   //! Render the next block of n_ samples applying each queued event on
+   //! the sample of its time stamp, with the voices partitioned between
+   //! the workers of a pool (see RenderPool)
+   template <typename POOL>
+   void render(POOL& pool_, int32_t* buffer_, unsigned n_)
+   {
+      renderEvents(n_,
+                   [this, &pool_, buffer_](unsigned offset_, unsigned len_)
+                   {
+                      getSamples(pool_, buffer_ + offset_, len_);
+                   });
+   }
+
+   //! Render the next block of n_ samples applying queued events as
+   //! render(), but with each worker of a pool rendering and ticking its
+   //! voices over the whole span between events, so the workers only
+   //! synchronise at events. scratch_ holds the partial mixes, n_ samples
+   //! for each worker, which are summed in worker order. The result is
+   //! identical to render()
+   template <typename POOL>
+   void renderByVoice(POOL& pool_, int32_t* buffer_, unsigned n_, int32_t* scratch_)
+   {
+      uint32_t start = clock.load(std::memory_order_relaxed);
 
-      for(unsigned i = first_voice_; i < num_voices_; ++i)
+      for(unsigned offset = 0; offset < n_; )
       {
-         VOICE& v = voice[i];
+         unsigned len = applyEvents(start + offset, n_ - offset);
+
+         partition(pool_.getNumWorkers());
+
+         const TickScheduler span_ticks = tick_scheduler;
+
+         pool_.run([this, scratch_, offset, len, n_, &span_ticks](unsigned worker_)
+                   {
+                      renderSpan(worker_voices.getMask(worker_),
+                                 scratch_ + worker_ * n_ + offset, len, span_ticks);
+                   });
+
+         for(unsigned i = offset; i < offset + len; ++i)
+         {
+            int32_t sum = 0;
 
-         if (not v.isMute())
-            mix += v();
+            for(unsigned w = 0; w < worker_voices.getNumWorkers(); ++w)
+               sum += scratch_[w * n_ + i];
+
+            buffer_[i] = sum / AMP;
+         }
+
+         // Catch up with the ticks the workers fired
+         for(unsigned i = 0; i < len; )
+         {
+            unsigned tick_len = tick_scheduler.samplesToTick(len - i);
+
+            tick_scheduler.advance(tick_len);
+
+            i += tick_len;
+         }
+
+         offset += len;
       }
 
-      return mix / AMP_N;
+      clock.store(start + n_, std::memory_order_relaxed);
+   }
+
+   //! Advance n_ samples applying queued events and control ticks as
+   //! render() but without producing any output, to seek within a
+   //! performance. Rendering continues exactly as if the skipped samples
+   //! had been rendered
+   void skip(unsigned n_)
+   {
+      renderEvents(n_,
+                   [this](unsigned offset_, unsigned len_)
+                   {
+                      VOICE*   active[NUM_VOICES];
+                      unsigned num_active = 0;
+
+                      forEachVoice(active_mask, 0, NUM_VOICES,
+                                   [&active, &num_active](VOICE& v)
+                                   {
+                                      active[num_active++] = &v;
+                                   });
+
+                      VOICE::skip(active, num_active, len_);
+                   });
+   }
+
+   //! Render the next block of n_ samples applying queued events as
+   //! render(), replaying the output of voices from a cache when they
+   //! continue from the same state as a recorded voice (see
+   //! DX7::NoteCache). The result is identical to render(). Once a cache
+   //! is in use every block must be rendered with it
+   template <typename CACHE>
+   void renderCached(CACHE& cache_, int32_t* buffer_, unsigned n_)
+   {
+      uint32_t start = clock.load(std::memory_order_relaxed);
+
+      for(unsigned offset = 0; offset < n_; )
+      {
+         unsigned len = applyEvents(start + offset, n_ - offset,
+                                    [this, &cache_](const Event& event_)
+                                    {
+                                       endSegments(cache_, event_);
+                                    });
+
+         len = tick_scheduler.samplesToTick(len);
+
+         mixCached(cache_, buffer_ + offset, len);
+
+         if (tick_scheduler.advance(len))
+         {
+            forEachVoice(active_mask, 0, NUM_VOICES,
+                         [this, &cache_](VOICE& v)
+                         {
+                            cache_.tick(&v - voice, v);
+                         });
+         }
+
+         offset += len;
+      }
+
+      clock.store(start + n_, std::memory_order_relaxed);
+   }
+
+   //! Get next sample
+   int32_t getSample(unsigned first_voice_= 0,
+                     unsigned num_voices_ = NUM_VOICES)
+   {
+      return mixSample(active_mask, first_voice_, num_voices_);
    }
 
    //! Get next pair of samples
    int32_t getSamplePair(unsigned first_voice_ = 0,
                          unsigned last_voice_  = NUM_VOICES)
+   {
+      return mixSamplePair(active_mask, first_voice_, last_voice_);
+   }
+
+   //! Get next block of samples
+   void getSamples(int32_t* buffer_,
+                   unsigned n_,
+                   unsigned first_voice_ = 0,
+                   unsigned last_voice_  = NUM_VOICES)
+   {
+      mixSamples(active_mask, buffer_, n_, first_voice_, last_voice_);
+   }
+
+   //! Control tick
+   void tick(unsigned first_voice_ = 0,
+             unsigned last_voice_  = NUM_VOICES)
+   {
+      tickVoices(active_mask, first_voice_, last_voice_);
+   }
+
+   //! Assign the sounding voices to render workers for the next tick,
+   //! balancing the estimated render cost of each worker. A voice that
+   //! starts after the assignment is rendered from the next assignment
+   void partition(unsigned num_workers_)
+   {
+      worker_voices.assign(active_mask, num_workers_,
+                           [this](unsigned index_)
+                           {
+                              return voice[index_].getRenderCost();
+                           });
+   }
+
+   //! Estimated cost of the voices assigned to a worker
+   uint32_t getWorkerLoad(unsigned worker_) const { return worker_voices.getLoad(worker_); }
+
+   //! Get next sample for the voices assigned to a worker
+   int32_t getWorkerSample(unsigned worker_)
+   {
+      return mixSample(worker_voices.getMask(worker_), 0, NUM_VOICES);
+   }
+
+   //! Get next pair of samples for the voices assigned to a worker
+   int32_t getWorkerSamplePair(unsigned worker_)
+   {
+      return mixSamplePair(worker_voices.getMask(worker_), 0, NUM_VOICES);
+   }
+
+   //! Get next block of samples for the voices assigned to a worker
+   void getWorkerSamples(int32_t* buffer_, unsigned n_, unsigned worker_)
+   {
+      mixSamples(worker_voices.getMask(worker_), buffer_, n_, 0, NUM_VOICES);
+   }
+
+   //! Get next block of samples with the voices partitioned between the
+   //! workers of a pool (see RenderPool), the result is identical to
+   //! getSamples() for all the voices
+   template <typename POOL>
+   void getSamples(POOL& pool_, int32_t* buffer_, unsigned n_)
+   {
+      partition(pool_.getNumWorkers());
+
+      pool_.mix(buffer_, n_,
+                [this](unsigned worker_, int32_t* partial_, unsigned block_)
+                {
+                   renderVoices(worker_voices.getMask(worker_), partial_, block_, 0, NUM_VOICES);
+                });
+
+      for(unsigned i = 0; i < n_; ++i)
+         buffer_[i] /= AMP;
+   }
+
+   //! Control tick for the voices assigned to a worker
+   void tickWorker(unsigned worker_)
+   {
+      tickVoices(worker_voices.getMask(worker_), 0, NUM_VOICES);
+   }
+
+protected:
+   //! Save or restore the render path state, see Snapshot. Between blocks
+   //! on the render thread with no MIDI input. patches_ saves the reference
+   //! to the patch of each voice, see VOICE::snapshot()
+   template <typename SNAPSHOT, typename PATCHES>
+   void snapshot(SNAPSHOT& s_, PATCHES& patches_)
+   {
+      channel.snapshot(s_);
+
+      for(unsigned i = 0; i < NUM_VOICES; ++i)
+      {
+         voice[i].snapshot(s_, patches_);
+      }
+
+      s_.field(active_mask);
+      s_.field(voice_map);
+      s_.field(worker_voices);
+
+      event_queue.snapshot(s_);
+      sysex_queue.snapshot(s_);
+      s_.field(sysex_tail);
+      s_.field(sysex_head);
+
+      uint32_t time = clock.load(std::memory_order_relaxed);
+      s_.field(time);
+      clock.store(time, std::memory_order_relaxed);
+
+      s_.field(event_time);
+      s_.field(event_time_set);
+      s_.field(tick_scheduler);
+   }
+
+   //! Apply a program change to a voice
+   virtual void programEvent(unsigned, uint8_t)
+   {
+   }
+
+   //! Apply a SYSEX byte
+   virtual void sysExEvent(uint8_t)
+   {
+   }
+
+   VOICE                   voice[NUM_VOICES];
+   typename VOICE::Channel channel;   //!< Controller state shared by the voices
+
+private:
+   using Partition = VoicePartition<NUM_VOICES, MAX_WORKERS>;
+
+   enum EventType : uint8_t
+   {
+      EVENT_MUTE,
+      EVENT_NOTE_ON,
+      EVENT_NOTE_OFF,
+      EVENT_PRESSURE,
+      EVENT_CONTROL,
+      EVENT_PITCH_BEND,
+      EVENT_PROGRAM,
+      EVENT_SYSEX
+   };
+
+   //! MIDI event passed from the MIDI::Instrument to the render path
+   struct Event
+   {
+      uint32_t  time;    //!< Sample time the event is due
+      EventType type;
+      uint8_t   index;   //!< MIDI::Instrument voice index, 0 for channel messages
+      uint8_t   data1;
+      uint8_t   data2;
+   };
+
+   //! Mix attenuation, signed so that negative mixes divide correctly
+   static const int32_t AMP = AMP_N;
+
+   //! Events held by tryQueue(), enough for one MIDI message
+   static const unsigned MAX_HELD = NUM_VOICES + 1;
+
+   static const unsigned MASK_BITS  = Partition::MASK_BITS;
+   static const unsigned MASK_WORDS = Partition::MASK_WORDS;
+
+   uint32_t  active_mask[MASK_WORDS] = {};   //!< Voices that may be sounding
+   uint8_t   voice_map[NUM_VOICES];          //!< MIDI::Instrument voice index => voice
+   Partition worker_voices{};                //!< Voices assigned to each render worker
+
+   EventQueue<Event, MAX_EVENTS>  event_queue{};        //!< MIDI input => render path
+   EventQueue<uint8_t, MAX_SYSEX> sysex_queue{};        //!< SYSEX bytes of EVENT_SYSEX
+   uint16_t                       sysex_tail{0};        //!< Producer count of SYSEX bytes queued
+   uint16_t                       sysex_head{0};        //!< Render path count of SYSEX bytes applied
+   Event                          held[MAX_HELD];       //!< Events waiting for flushEvents()
+   unsigned                       num_held{0};
+   bool                           hold_events{false};   //!< Within tryQueue()
+   uint32_t                       dropped_events{0};    //!< Events and SYSEX bytes lost
+   std::atomic<uint32_t>          clock{0};             //!< Sample time of the next block
+   uint32_t                       event_time{0};        //!< Producer time stamp, see setEventTime()
+   bool                           event_time_set{false};
+
+   TickScheduler tick_scheduler{};   //!< Control ticks fired by render()
+
+   int32_t mixSample(const uint32_t* mask_, unsigned first_voice_, unsigned last_voice_)
+   {
+      int32_t mix {0};
+
+      forEachVoice(mask_, first_voice_, last_voice_,
+                   [&mix](VOICE& v)
+                   {
+                      mix += v();
+                   });
+
+      return mix / AMP;
+   }
+
+   int32_t mixSamplePair(const uint32_t* mask_, unsigned first_voice_, unsigned last_voice_)
    {
       int32_t mix1 {0};
       int32_t mix2 {0};
 
-      for(unsigned i = first_voice_; i < last_voice_; ++i)
+      forEachVoice(mask_, first_voice_, last_voice_,
+                   [&mix1, &mix2](VOICE& v)
+                   {
+                      mix1 += v();
+                      mix2 += v();
+                   });
+
+      mix1 /= AMP;
+      mix2 /= AMP;
+
+      return (mix1 << 16) | (mix2 & 0xFFFF);
+   }
+
+   void mixSamples(const uint32_t* mask_,
+                   int32_t*        buffer_,
+                   unsigned        n_,
+                   unsigned        first_voice_,
+                   unsigned        last_voice_)
+   {
+      // Idle, no voice state is touched
+      if (not renderVoices(mask_, buffer_, n_, first_voice_, last_voice_))
+         return;
+
+      for(unsigned i = 0; i < n_; ++i)
+         buffer_[i] /= AMP;
+   }
+
+   //! Write the unscaled mix of the sounding voices in mask_, returns
+   //! false if there were none
+   bool renderVoices(const uint32_t* mask_,
+                     int32_t*        buffer_,
+                     unsigned        n_,
+                     unsigned        first_voice_,
+                     unsigned        last_voice_)
+   {
+      for(unsigned i = 0; i < n_; ++i)
+         buffer_[i] = 0;
+
+      VOICE*   active[NUM_VOICES];
+      unsigned num_active = 0;
+
+      forEachVoice(mask_, first_voice_, last_voice_,
+                   [&active, &num_active](VOICE& v)
+                   {
+                      active[num_active++] = &v;
+                   });
+
+      if (num_active == 0)
+         return false;
+
+      VOICE::render(active, num_active, buffer_, n_);
+
+      return true;
+   }
+
+   //! Mix n_ samples of the sounding voices replaying or recording their
+   //! output with a cache, voices the cache does not record are rendered
+   //! together
+   template <typename CACHE>
+   void mixCached(CACHE& cache_, int32_t* buffer_, unsigned n_)
+   {
+      for(unsigned i = 0; i < n_; ++i)
+         buffer_[i] = 0;
+
+      VOICE*   active[NUM_VOICES];
+      unsigned num_active = 0;
+
+      forEachVoice(active_mask, 0, NUM_VOICES,
+                   [&active, &num_active](VOICE& v)
+                   {
+                      active[num_active++] = &v;
+                   });
+
+      unsigned num_live = cache_.render(voice, active, num_active,
+                                        channel, tick_scheduler, buffer_, n_);
+
+      if (num_live != 0)
+         VOICE::render(active, num_live, buffer_, n_);
+
+      for(unsigned i = 0; i < n_; ++i)
+         buffer_[i] /= AMP;
+   }
+
+   //! End the cache segments of the voices that an event changes before it
+   //! is applied. A note on that steals a voice reads the state of every
+   //! voice, changes to the channel and patches affect every voice
+   template <typename CACHE>
+   void endSegments(CACHE& cache_, const Event& event_)
+   {
+      switch(event_.type)
       {
-         VOICE& v = voice[i];
+      case EVENT_MUTE:
+      case EVENT_NOTE_OFF:
+         cache_.end(voice_map[event_.index], voice[voice_map[event_.index]]);
+         return;
 
-         if (not v.isMute())
+      case EVENT_NOTE_ON:
+         if (voice[voice_map[event_.index]].isMute())
          {
-            mix1 += v();
-            mix2 += v();
+            cache_.end(voice_map[event_.index], voice[voice_map[event_.index]]);
+            return;
          }
+         break;
+
+      // A channel message that leaves the channel state unchanged does
+      // not change any voice
+      case EVENT_PRESSURE:
+         if (event_.data1 == channel.getPressure())
+            return;
+         break;
+
+      case EVENT_CONTROL:
+         if ((event_.data1 != 119) && (event_.data2 == channel.getControl(event_.data1)))
+            return;
+         break;
+
+      case EVENT_PITCH_BEND:
+         if (int16_t(event_.data1 | (event_.data2 << 8)) == channel.getPitchBend())
+            return;
+         break;
+
+      case EVENT_PROGRAM:
+      case EVENT_SYSEX:
+         break;
       }
 
-      mix1 /= AMP_N;
-      mix2 /= AMP_N;
+      bool live = event_.type != EVENT_NOTE_ON;
 
-      return (mix1 << 16) | (mix2 & 0xFFFF);
+      for(unsigned i = 0; i < NUM_VOICES; ++i)
+         cache_.end(i, voice[i], live);
    }
 
-   //! Control tick
-   void tick(unsigned first_voice_ = 0,
-             unsigned last_voice_  = NUM_VOICES)
+   void tickVoices(const uint32_t* mask_, unsigned first_voice_, unsigned last_voice_)
    {
-      for(unsigned i = first_voice_; i < last_voice_; ++i)
+      forEachVoice(mask_, first_voice_, last_voice_,
+                   [](VOICE& v)
+                   {
+                      v.tick();
+                   });
+   }
+
+   //! Call fn_ for each sounding voice in mask_ in the range [first_voice_, last_voice_)
+   //! The masks are only written by the MIDI event handlers and partition().
+   //! Render and tick may run for disjoint ranges or workers concurrently
+   //! and only read them
+   template <typename FN>
+   void forEachVoice(const uint32_t* mask_, unsigned first_voice_, unsigned last_voice_, FN fn_)
+   {
+      for(unsigned w = first_voice_ / MASK_BITS; w < MASK_WORDS; ++w)
       {
-         VOICE& v = voice[i];
+         unsigned base = w * MASK_BITS;
+         if (base >= last_voice_)
+            break;
+
+         uint32_t mask = mask_[w];
+
+         if (first_voice_ > base)
+            mask &= ~0u << (first_voice_ - base);
 
-         if (not v.isMute())
-            v.tick();
+         if ((last_voice_ - base) < MASK_BITS)
+            mask &= ~(~0u << (last_voice_ - base));
+
+         while(mask != 0)
+         {
+            VOICE& v = voice[base + __builtin_ctz(mask)];
+
+            // A voice that completed since the last MIDI event stays in
+            // the mask until the next one
+            if (not v.isMute())
+               fn_(v);
+
+            mask &= mask - 1;
+         }
       }
    }
 
-protected:
-   VOICE  voice[NUM_VOICES];
+   //! Remove voices that have completed from the active mask
+   void pruneActive()
+   {
+      for(unsigned w = 0; w < MASK_WORDS; ++w)
+      {
+         uint32_t mask = active_mask[w];
+
+         for(uint32_t m = mask; m != 0; m &= m - 1)
+         {
+            unsigned bit = __builtin_ctz(m);
+
+            if (voice[w * MASK_BITS + bit].isMute())
+               mask &= ~(1u << bit);
+         }
+
+         active_mask[w] = mask;
+      }
+   }
+
+   void setActive(unsigned index_)
+   {
+      active_mask[index_ / MASK_BITS] |= 1u << (index_ % MASK_BITS);
+   }
+
+   void clearActive(unsigned index_)
+   {
+      active_mask[index_ / MASK_BITS] &= ~(1u << (index_ % MASK_BITS));
+   }
+
+   //! Voice for a new note on the voice the MIDI::Instrument allocated.
+   //! The instrument has no knowledge of envelope state, so when it takes
+   //! a voice that is still sounding the cheapest voice to steal is used
+   //! instead. The instrument's choice is then released, not cut, and
+   //! handed to the previous owner of the stolen voice
+   unsigned allocVoice(unsigned index_)
+   {
+      unsigned choice = voice_map[index_];
+
+      if (voice[choice].isMute())
+         return choice;
+
+      unsigned steal      = choice;
+      uint32_t steal_cost = voice[choice].getStealCost();
+
+      for(unsigned i = 0; (i < NUM_VOICES) && (steal_cost != 0); ++i)
+      {
+         uint32_t cost = voice[i].getStealCost();
+         if (cost < steal_cost)
+         {
+            steal      = i;
+            steal_cost = cost;
+         }
+      }
+
+      if (steal == choice)
+         return choice;
+
+      for(unsigned i = 0; i < NUM_VOICES; ++i)
+      {
+         if (voice_map[i] == steal)
+         {
+            voice_map[i] = choice;
+            break;
+         }
+      }
+
+      voice_map[index_] = steal;
+
+      if (voice[choice].isOn())
+         voice[choice].noteOff(/* velocity */ 0);
+
+      return steal;
+   }
 
-private:
    virtual bool filterNote(uint8_t midi_note_)
    {
       return false;
    }
 
-   // MIDI::Instrument implementation
-   void voiceMute(unsigned index_) override
+   //! Render n_ samples in spans that end where the next queued event or
+   //! control tick is due, render_(offset, length) renders one span
+   template <typename RENDER>
+   void renderEvents(unsigned n_, RENDER render_)
    {
-      voice[index_].noteOff(/* velocity */ 0);
-      voice[index_].mute();
+      uint32_t start = clock.load(std::memory_order_relaxed);
+
+      for(unsigned offset = 0; offset < n_; )
+      {
+         unsigned len = applyEvents(start + offset, n_ - offset);
+
+         len = tick_scheduler.samplesToTick(len);
+
+         render_(offset, len);
+
+         if (tick_scheduler.advance(len))
+            tickVoices(active_mask, 0, NUM_VOICES);
+
+         offset += len;
+      }
+
+      clock.store(start + n_, std::memory_order_relaxed);
    }
 
-   void voiceOn(unsigned index_, uint8_t midi_note_, uint8_t velocity_) override
+   //! Write the unscaled mix of the voices in mask_ for n_ samples with
+   //! no events, ticking the voices on the ticks of a copy of ticks_
+   void renderSpan(const uint32_t* mask_, int32_t* buffer_, unsigned n_, TickScheduler ticks_)
    {
-      if (not filterNote(midi_note_))
+      for(unsigned offset = 0; offset < n_; )
       {
-         voice[index_].noteOn(midi_note_, velocity_);
+         unsigned len = ticks_.samplesToTick(n_ - offset);
+
+         renderVoices(mask_, buffer_ + offset, len, 0, NUM_VOICES);
+
+         if (ticks_.advance(len))
+            tickVoices(mask_, 0, NUM_VOICES);
+
+         offset += len;
       }
    }
 
-   void voiceOff(unsigned index_, uint8_t velocity_) override
+   //! Apply the queued events due at or before time_, returns the number
+   //! of samples, up to max_, until the next event is due
+   unsigned applyEvents(uint32_t time_, unsigned max_)
    {
-      voice[index_].noteOff(velocity_);
+      return applyEvents(time_, max_, [](const Event&) {});
    }
 
-   void voicePressure(unsigned index_, uint8_t level_) override
+   //! Apply the queued events as applyEvents() calling before_(event)
+   //! before each is applied
+   template <typename FN>
+   unsigned applyEvents(uint32_t time_, unsigned max_, FN before_)
    {
-      voice[index_].setPressure(level_);
+      const Event* event;
+
+      while((event = event_queue.front()) != nullptr)
+      {
+         int32_t due = int32_t(event->time - time_);
+
+         if (due > 0)
+            return unsigned(due) < max_ ? unsigned(due) : max_;
+
+         before_(*event);
+         applyEvent(*event);
+         event_queue.pop();
+      }
+
+      return max_;
    }
 
-   void voiceControl(unsigned index_, uint8_t control_, uint8_t value_) override
+   //! Queue an event for the render path, returns false if the queue is
+   //! full. The queue is drained every block so it only fills with more
+   //! than MAX_EVENTS messages between two blocks. Waiting for space could
+   //! hang a producer that runs before, or on the same thread as, the
+   //! render path so the event is held within tryQueue() or otherwise
+   //! dropped and counted
+   bool queueEvent(EventType type_, unsigned index_, uint8_t data1_ = 0, uint8_t data2_ = 0)
+   {
+      uint32_t time = event_time_set ? event_time
+                                     : clock.load(std::memory_order_relaxed);
+
+      Event event{time, type_, uint8_t(index_), data1_, data2_};
+
+      // Events already held go first
+      if ((num_held == 0) && event_queue.push(event))
+         return true;
+
+      if (hold_events && (num_held < MAX_HELD))
+      {
+         held[num_held++] = event;
+         return true;
+      }
+
+      ++dropped_events;
+      return false;
+   }
+
+   void applyEvent(const Event& event_)
+   {
+      switch(event_.type)
+      {
+      case EVENT_MUTE:
+         muteEvent(event_.index);
+         break;
+
+      case EVENT_NOTE_ON:
+         noteOnEvent(event_.index, event_.data1, event_.data2);
+         break;
+
+      case EVENT_NOTE_OFF:
+         noteOffEvent(event_.index, event_.data1);
+         break;
+
+      case EVENT_PRESSURE:
+         channel.setPressure(event_.data1);
+         break;
+
+      case EVENT_CONTROL:
+         controlEvent(event_.data1, event_.data2);
+         break;
+
+      case EVENT_PITCH_BEND:
+         channel.setPitchBend(int16_t(event_.data1 | (event_.data2 << 8)));
+         break;
+
+      case EVENT_PROGRAM:
+         programAll(event_.data1);
+         break;
+
+      case EVENT_SYSEX:
+         sysExMessage(uint16_t(event_.data1 | (event_.data2 << 8)));
+         break;
+      }
+   }
+
+   //! Apply the queued SYSEX bytes up to the count end_ stamped on the
+   //! event. The bytes of a dropped EVENT_SYSEX are applied with the next
+   void sysExMessage(uint16_t end_)
+   {
+      const uint8_t* byte;
+
+      while((sysex_head != end_) && ((byte = sysex_queue.front()) != nullptr))
+      {
+         sysExEvent(*byte);
+         sysex_queue.pop();
+         ++sysex_head;
+      }
+   }
+
+   void muteEvent(unsigned index_)
+   {
+      unsigned v = voice_map[index_];
+
+      clearActive(v);
+
+      voice[v].noteOff(/* velocity */ 0);
+      voice[v].mute();
+   }
+
+   void noteOnEvent(unsigned index_, uint8_t midi_note_, uint8_t velocity_)
+   {
+      if (not filterNote(midi_note_))
+      {
+         pruneActive();
+
+         unsigned v = allocVoice(index_);
+
+         voice[v].noteOn(midi_note_, velocity_);
+
+         setActive(v);
+      }
+   }
+
+   void noteOffEvent(unsigned index_, uint8_t velocity_)
+   {
+      unsigned v = voice_map[index_];
+
+      pruneActive();
+
+      voice[v].noteOff(velocity_);
+
+      // A note off leaves even a muted voice in the released state
+      setActive(v);
+   }
+
+   void controlEvent(uint8_t control_, uint8_t value_)
    {
       if (control_ == 119)
       {
          // Hack to allow program selection via CC119 for DAWs that
          // charge extra for easy MIDI program selection
-         this->voiceProgram(index_, value_);
+         programAll(value_);
          return;
       }
 
-      voice[index_].setControl(control_, value_);
+      channel.setControl(control_, value_);
+   }
+
+   //! Fan a program change out to every voice
+   void programAll(uint8_t number_)
+   {
+      for(unsigned i = 0; i < NUM_VOICES; ++i)
+      {
+         programEvent(i, number_);
+      }
+   }
+
+   // MIDI::Instrument implementation, events are queued for the render
+   // path. Channel messages arrive once for each voice index, only the
+   // delivery to index 0 is queued and applyEvent() applies it to the
+   // shared channel state or every voice
+
+   void voiceMute(unsigned index_) override final
+   {
+      queueEvent(EVENT_MUTE, index_);
+   }
+
+   void voiceOn(unsigned index_, uint8_t midi_note_, uint8_t velocity_) override final
+   {
+      queueEvent(EVENT_NOTE_ON, index_, midi_note_, velocity_);
+   }
+
+   void voiceOff(unsigned index_, uint8_t velocity_) override final
+   {
+      queueEvent(EVENT_NOTE_OFF, index_, velocity_);
+   }
+
+   void voicePressure(unsigned index_, uint8_t level_) override final
+   {
+      if (index_ == 0)
+         queueEvent(EVENT_PRESSURE, 0, level_);
+   }
+
+   void voiceControl(unsigned index_, uint8_t control_, uint8_t value_) override final
+   {
+      if (index_ == 0)
+         queueEvent(EVENT_CONTROL, 0, control_, value_);
+   }
+
+   void voicePitchBend(unsigned index_, int16_t value_) override final
+   {
+      if (index_ == 0)
+         queueEvent(EVENT_PITCH_BEND, 0, uint16_t(value_) & 0xFF, uint16_t(value_) >> 8);
    }
 
-   void voicePitchBend(unsigned index_, int16_t value_) override
+   void voiceProgram(unsigned index_, uint8_t number_) override final
    {
-      voice[index_].setPitchBend(value_);
+      if (index_ == 0)
+         queueEvent(EVENT_PROGRAM, 0, number_);
    }
 };
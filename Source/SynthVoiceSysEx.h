@@ -23,7 +23,7 @@ protected:
    uint8_t  sysex_buffer[MAX_SYSEX_SIZE];
 
 private:
-   void sysEx(uint8_t byte_) override
+   void sysExEvent(uint8_t byte_) override
    {
       if (byte_ == 0xF0)
       {
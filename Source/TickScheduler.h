@@ -0,0 +1,58 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief Control tick scheduler
+
+#pragma once
+
+#include <cstdint>
+
+//! Schedules a control tick every sample_rate / tick_rate samples using a
+//! fractional accumulator, so the average tick rate is exact and does not
+//! depend on how the samples are split into blocks. A scheduler with a
+//! tick rate of zero never ticks
+class TickScheduler
+{
+public:
+   TickScheduler() = default;
+
+   TickScheduler(unsigned sample_rate_, unsigned tick_rate_)
+      : sample_rate(sample_rate_)
+      , tick_rate(tick_rate_)
+   {
+   }
+
+   //! Samples, up to max_, until the next tick is due
+   unsigned samplesToTick(unsigned max_) const
+   {
+      if (tick_rate == 0)
+         return max_;
+
+      uint32_t n = (sample_rate - phase + tick_rate - 1) / tick_rate;
+
+      return n < max_ ? n : max_;
+   }
+
+   //! Advance by n_ samples, no more than samplesToTick(), returns true
+   //! if a tick is due
+   bool advance(unsigned n_)
+   {
+      if (tick_rate == 0)
+         return false;
+
+      phase += n_ * tick_rate;
+
+      if (phase < sample_rate)
+         return false;
+
+      phase -= sample_rate;
+      return true;
+   }
+
+private:
+   uint32_t sample_rate{0};
+   uint32_t tick_rate{0};
+   uint32_t phase{0};       //!< Fraction of the tick period elapsed x sample_rate
+};
@@ -8,6 +8,11 @@
 #include <cstdint>
 
 //! Base class for voices used with SynthBase
+//! The hooks are resolved at compile time in the derived class VOICE,
+//! which must implement gateOn() and gateOff(). VOICE should befriend
+//! VoiceBase<VOICE> to keep its hooks private. Pitch bend, aftertouch and
+//! controls are channel state, see ChannelBase
+template <typename VOICE>
 class VoiceBase
 {
    enum State { MUTE, ON, OFF };
@@ -33,7 +38,7 @@ public:
       state = MUTE;
       level = 0;
 
-      gateOff();
+      derived().gateOff();
    }
 
    //! MIDI note on event for this voice
@@ -43,7 +48,7 @@ public:
       note  = note_;
       level = velocity_;
 
-      gateOn();
+      derived().gateOn();
    }
 
    //! MIDI note off event for this voice
@@ -52,44 +57,23 @@ public:
       state = OFF;
       level = velocity_;
 
-      gateOff();
+      derived().gateOff();
    }
 
-   //! Update MIDI pitch bend
-   void setPitchBend(int16_t value_)
+   //! Save or restore the note state, see Snapshot
+   template <typename SNAPSHOT>
+   void snapshot(SNAPSHOT& s_)
    {
-      pitch = value_;
-
-      updatePitch();
-   }
-
-   //! Update voice level from MIDI aftertouch
-   void setPressure(uint8_t value_)
-   {
-      level = value_;
-
-      updateLevel();
-   }
-
-   //! Update MIDI controls
-   void setControl(uint8_t number_, uint8_t value_)
-   {
-      control[number_] = value_;
-
-      updateControl(number_, value_);
+      s_.field(state);
+      s_.field(note);
+      s_.field(level);
    }
 
 protected:
-   // Override for voice implementation
-   virtual void gateOn() = 0;
-   virtual void gateOff() = 0;
-   virtual void updatePitch() {}
-   virtual void updateLevel() {}
-   virtual void updateControl(uint8_t number_, uint8_t value_) {}
-
    State   state {MUTE};
-   int16_t pitch {0};
    uint8_t note {0};
    uint8_t level {0};
-   uint8_t control[128] = {0};
+
+private:
+   VOICE& derived() { return *static_cast<VOICE*>(this); }
 };
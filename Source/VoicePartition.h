@@ -0,0 +1,100 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+
+//! Assignment of sounding voices to render workers. Voices are placed in
+//! order of decreasing cost, each on the worker with the lowest total
+//! cost so far, so the workers finish at about the same time whichever
+//! voices the notes were allocated to
+template <unsigned NUM_VOICES, unsigned MAX_WORKERS>
+class VoicePartition
+{
+public:
+   static const unsigned MASK_BITS  = 32;
+   static const unsigned MASK_WORDS = (NUM_VOICES + MASK_BITS - 1) / MASK_BITS;
+
+   VoicePartition() = default;
+
+   //! Number of workers in the current assignment
+   unsigned getNumWorkers() const { return num_workers; }
+
+   //! Voices assigned to a worker
+   const uint32_t* getMask(unsigned worker_) const { return mask[worker_]; }
+
+   //! Estimated cost of the voices assigned to a worker
+   uint32_t getLoad(unsigned worker_) const { return load[worker_]; }
+
+   //! Assign the voices in active_mask_ to num_workers_ workers, cost_(index)
+   //! returns the estimated render cost of a voice, 0 for a voice that
+   //! does not need rendering
+   template <typename COST_FN>
+   void assign(const uint32_t* active_mask_, unsigned num_workers_, COST_FN cost_)
+   {
+      num_workers = num_workers_ < 1           ? 1
+                  : num_workers_ > MAX_WORKERS ? MAX_WORKERS
+                                               : num_workers_;
+
+      for(unsigned w = 0; w < MAX_WORKERS; ++w)
+      {
+         load[w] = 0;
+
+         for(unsigned i = 0; i < MASK_WORDS; ++i)
+            mask[w][i] = 0;
+      }
+
+      // Insertion sort of the voices to be rendered by decreasing cost,
+      // equal costs stay in voice order so the assignment is repeatable
+      unsigned num_items = 0;
+
+      for(unsigned i = 0; i < MASK_WORDS; ++i)
+      {
+         for(uint32_t m = active_mask_[i]; m != 0; m &= m - 1)
+         {
+            unsigned index = i * MASK_BITS + __builtin_ctz(m);
+            uint32_t cost  = cost_(index);
+
+            if (cost == 0)
+               continue;
+
+            unsigned j = num_items++;
+
+            for(; (j > 0) && (item[j - 1].cost < cost); --j)
+               item[j] = item[j - 1];
+
+            item[j].index = index;
+            item[j].cost  = cost;
+         }
+      }
+
+      for(unsigned i = 0; i < num_items; ++i)
+      {
+         unsigned w = 0;
+
+         for(unsigned k = 1; k < num_workers; ++k)
+         {
+            if (load[k] < load[w])
+               w = k;
+         }
+
+         load[w] += item[i].cost;
+         mask[w][item[i].index / MASK_BITS] |= 1u << (item[i].index % MASK_BITS);
+      }
+   }
+
+private:
+   struct Item
+   {
+      uint16_t index;
+      uint32_t cost;
+   };
+
+   unsigned num_workers{1};
+   uint32_t load[MAX_WORKERS] = {};
+   uint32_t mask[MAX_WORKERS][MASK_WORDS] = {};
+   Item     item[NUM_VOICES];
+};
@@ -0,0 +1,135 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief WAV file writer
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+//! Writer for 16-bit PCM WAV files. The header sizes are filled in when
+//! the file is closed
+class WavFile
+{
+public:
+   WavFile(unsigned sample_rate_, unsigned num_channels_ = 1)
+      : sample_rate(sample_rate_)
+      , num_channels(num_channels_)
+   {
+   }
+
+   ~WavFile()
+   {
+      close();
+   }
+
+   //! Create the file, returns false on failure
+   bool open(const char* filename_)
+   {
+      close();
+
+      fp = fopen(filename_, "wb");
+      if (fp == nullptr)
+         return false;
+
+      data_size = 0;
+
+      writeHeader();
+
+      return ok;
+   }
+
+   //! Write n_ frames of interleaved samples
+   void write(const int16_t* samples_, size_t n_)
+   {
+      size_t  n = n_ * num_channels;
+      uint8_t bytes[512];
+
+      for(size_t i = 0; i < n; )
+      {
+         size_t len = 0;
+
+         for(; (i < n) && (len < sizeof(bytes)); ++i)
+         {
+            bytes[len++] = uint8_t(samples_[i]);
+            bytes[len++] = uint8_t(uint16_t(samples_[i]) >> 8);
+         }
+
+         if (fwrite(bytes, 1, len, fp) != len)
+            ok = false;
+      }
+
+      data_size += n * sizeof(int16_t);
+   }
+
+   //! Complete the header and close the file, returns false if any
+   //! write failed
+   bool close()
+   {
+      if (fp == nullptr)
+         return true;
+
+      if (fseek(fp, 0, SEEK_SET) == 0)
+         writeHeader();
+      else
+         ok = false;
+
+      bool result = ok && (fclose(fp) == 0);
+
+      fp = nullptr;
+      ok = true;
+
+      return result;
+   }
+
+private:
+   void writeHeader()
+   {
+      unsigned bytes_per_frame = num_channels * sizeof(int16_t);
+
+      tag("RIFF");
+      u32(36 + data_size);
+      tag("WAVE");
+
+      tag("fmt ");
+      u32(16);
+      u16(1);                               // PCM
+      u16(num_channels);
+      u32(sample_rate);
+      u32(sample_rate * bytes_per_frame);   // byte rate
+      u16(bytes_per_frame);
+      u16(16);                              // bits per sample
+
+      tag("data");
+      u32(data_size);
+   }
+
+   void tag(const char* tag_)
+   {
+      if (fwrite(tag_, 1, 4, fp) != 4)
+         ok = false;
+   }
+
+   void u16(uint16_t value_)
+   {
+      uint8_t bytes[2] = {uint8_t(value_), uint8_t(value_ >> 8)};
+
+      if (fwrite(bytes, 1, 2, fp) != 2)
+         ok = false;
+   }
+
+   void u32(uint32_t value_)
+   {
+      u16(value_);
+      u16(value_ >> 16);
+   }
+
+   const unsigned sample_rate;
+   const unsigned num_channels;
+   FILE*          fp{nullptr};
+   uint32_t       data_size{0};
+   bool           ok{true};
+};
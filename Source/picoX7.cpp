@@ -21,6 +21,12 @@
 
 #include "DX7/Synth.h"
 
+#if defined(HW_DAC_NATIVE)
+#include <cstdlib>
+
+#include "RenderPool.h"
+#endif
+
 #if not defined(HW_NATIVE)
 
 //! Select a system clock with clean division to 49.1 KHz
@@ -42,6 +48,9 @@ static const unsigned NUM_VOICES       = 16;                    //!< Polyphony
 static const bool     MIDI_DEBUG       = false;
 static const bool     PROFILE          = false;
 static const unsigned NUM_SYNTHS       = 1;
+static const unsigned NUM_CORES        = 2;                     //!< Render workers
+static const unsigned MIDI_POLL_PERIOD = 1000;                  //!< MIDI input poll period (uS)
+static const unsigned UI_POLL_PERIOD   = 100;                   //!< MIDI polls per UI update
 
 
 static DX7::Synth<NUM_VOICES, /* AMP_N */ 4> dx7{};
@@ -84,16 +93,21 @@ void MTL::Audio::getSamples(uint32_t* buffer, unsigned n)
 {
    profiler_core0.start();
 
+   dx7.processEvents(SAMPLES_PER_TICK);
+
+   // Balance the sounding voices between the cores for this tick
+   dx7.partition(NUM_CORES);
+
    // Wakeup core-1 with
    sio.txFifoPush(uint32_t(buffer));
    __asm__("sev");
 
    for(unsigned i = 0; i < SAMPLES_PER_TICK; i += 2)
    {
-      buffer[i + 1] = dx7.getSamplePair(0, NUM_VOICES / 2);
+      buffer[i + 1] = dx7.getWorkerSamplePair(/* worker */ 0);
    }
 
-   dx7.tick(0, NUM_VOICES / 2);
+   dx7.tickWorker(/* worker */ 0);
 
    profiler_core0.stop();
 }
@@ -114,10 +128,10 @@ void main_1()
 
       for(unsigned i = 0; i < SAMPLES_PER_TICK; i += 2)
       {
-         buffer[i + 0] = dx7.getSamplePair(NUM_VOICES / 2, NUM_VOICES);
+         buffer[i + 0] = dx7.getWorkerSamplePair(/* worker */ 1);
       }
 
-      dx7.tick(NUM_VOICES / 2, NUM_VOICES);
+      dx7.tickWorker(/* worker */ 1);
 
       profiler_core1.stop();
    }
@@ -134,6 +148,11 @@ void MTL::Audio::getSamples(uint32_t* buffer, unsigned n)
 {
    profiler_core0.start();
 
+   dx7.processEvents(SAMPLES_PER_TICK);
+
+   // Balance the sounding voices between the cores for this tick
+   dx7.partition(NUM_CORES);
+
    // Wakeup core-1 with
    sio.txFifoPush(uint32_t(buffer));
    __asm__("sev");
@@ -142,11 +161,11 @@ void MTL::Audio::getSamples(uint32_t* buffer, unsigned n)
 
    for(unsigned i = 0; i < SAMPLES_PER_TICK; i++)
    {
-      int16_t sample = dx7.getSample(0, NUM_VOICES / 2);
+      int16_t sample = dx7.getWorkerSample(/* worker */ 0);
       left_buffer[i * 2] = audio.packSamples(sample, 0);
    }
 
-   dx7.tick(0, NUM_VOICES / 2);
+   dx7.tickWorker(/* worker */ 0);
 
    profiler_core0.stop();
 }
@@ -167,11 +186,11 @@ void main_1()
 
       for(unsigned i = 0; i < SAMPLES_PER_TICK; i++)
       {
-         int16_t sample = dx7.getSample(NUM_VOICES / 2, NUM_VOICES);
+         int16_t sample = dx7.getWorkerSample(/* worker */ 1);
          right_buffer[i * 2] = audio.packSamples(sample, 0);
       }
 
-      dx7.tick(NUM_VOICES / 2, NUM_VOICES);
+      dx7.tickWorker(/* worker */ 1);
 
       profiler_core1.stop();
    }
@@ -179,19 +198,40 @@ void main_1()
 
 #elif defined(HW_DAC_NATIVE)
 
+//! Native render workers, from PICOX7_RENDER_THREADS (1-8) if it is set.
+//! The default is a single worker until the pool is shown to scale with
+//! bench_render_pool on a multi-core host
+static unsigned numRenderThreads()
+{
+   const char* value   = getenv("PICOX7_RENDER_THREADS");
+   int         threads = value != nullptr ? atoi(value) : 1;
+
+   return threads > 1 ? unsigned(threads) : 1;
+}
+
+static RenderPool render_pool{numRenderThreads()};
+
 template<>
 void hw::Audio<SAMPLES_PER_TICK>::getSamples32(uint32_t* buffer, unsigned n)
 {
    (void) BUFFER_SIZE;
 
-   for(unsigned i = 0; i < n; ++i)
+   // Control ticks are scheduled by the synth so the block size only
+   // bounds the mix buffer
+   for(unsigned i = 0; i < n; i += RenderPool::MAX_BLOCK)
    {
-      int16_t mono = dx7.getSample(0, NUM_VOICES);
+      int32_t  mix[RenderPool::MAX_BLOCK];
+      unsigned block = n - i < RenderPool::MAX_BLOCK ? n - i : RenderPool::MAX_BLOCK;
 
-      buffer[i] = (mono << 16) | (mono & 0xFFFF);
-   }
+      dx7.render(render_pool, mix, block);
+
+      for(unsigned j = 0; j < block; ++j)
+      {
+         int16_t mono = mix[j];
 
-   synth->tick(0, NUM_VOICES);
+         buffer[i + j] = (mono << 16) | (mono & 0xFFFF);
+      }
+   }
 }
 
 #endif
@@ -232,6 +272,10 @@ void initSynth()
 
    synth->init();
 
+#if defined(HW_DAC_NATIVE)
+   dx7.setTickRate(DAC_FREQ, TICK_RATE);
+#endif
+
    synth->programChange(0, 0);
 }
 
@@ -264,9 +308,18 @@ int main()
 
    while(true)
    {
+      // MIDI events are queued for the render path, polling often keeps
+      // the latency below a control tick
+      for(unsigned i = 0; i < UI_POLL_PERIOD; ++i)
+      {
+         hwTick();
+
+         usleep(MIDI_POLL_PERIOD);
+      }
+
       led = synth->isAnyVoiceOn();
 
-      hwTick();
+      synth->updateDisplay();
 
       if (PROFILE)
          profileReport();
@@ -301,8 +354,6 @@ int main()
             initSynth();
          }
       }
-
-      usleep(100000);
    }
 
    return 0;
@@ -0,0 +1,237 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2025 John D. Haughton
+// SPDX-License-Identifier: MIT
+//-------------------------------------------------------------------------------
+
+// \brief Offline render of a Standard MIDI File to a WAV file
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "DX7/NoteCache.h"
+#include "DX7/Synth.h"
+
+#include "MidiFile.h"
+#include "RenderPool.h"
+#include "WavFile.h"
+
+static const unsigned DAC_FREQ     = 49096;   //!< Output sample rate (Hz)
+static const unsigned TICK_RATE    = 375;     //!< 6800 firmware tick (375 Hz)
+static const unsigned NUM_VOICES   = 16;      //!< Polyphony
+static const unsigned BLOCK        = 2048;    //!< Samples per render call
+static const unsigned TAIL_SECONDS = 2;       //!< Render after the end of the file for releases
+
+static DX7::Synth<NUM_VOICES, /* AMP_N */ 4> dx7{};
+
+using NoteCache = DX7::NoteCache<DX7::Voice<>, NUM_VOICES>;
+
+//! Send a channel message through the MIDI::Instrument interface
+static void sendEvent(const MidiFile::Event& event_)
+{
+   switch(event_.status >> 4)
+   {
+   case 0x8:
+      dx7.noteOff(event_.data1, event_.data2);
+      break;
+
+   case 0x9:
+      if (event_.data2 == 0)
+         dx7.noteOff(event_.data1, 0);
+      else
+         dx7.noteOn(event_.data1, event_.data2);
+      break;
+
+   case 0xB:
+      dx7.controlChange(event_.data1, event_.data2);
+      break;
+
+   case 0xC:
+      dx7.programChange(0, event_.data1);
+      break;
+
+   case 0xD:
+      dx7.channelPressure(event_.data1);
+      break;
+
+   case 0xE:
+      dx7.pitchBend(int16_t(((event_.data2 << 7) | event_.data1) - 0x2000));
+      break;
+
+   default:
+      // Polyphonic key pressure is not supported
+      break;
+   }
+}
+
+static int usage(const char* program_)
+{
+   fprintf(stderr, "Usage: %s [-p <program>] [-c <channel>] [-j <threads>] [-s <seconds>] [-n <MiB>] <input.mid> <output.wav>\n", program_);
+   fprintf(stderr, "   -p <program>  DX7 program 1-128 selected before the file plays [1]\n");
+   fprintf(stderr, "   -c <channel>  Only play MIDI channel 1-16 [all]\n");
+   fprintf(stderr, "   -j <threads>  Render voices on 1-%u threads [1]\n", RenderPool::MAX_WORKERS);
+   fprintf(stderr, "   -s <seconds>  Start the output this far into the file [0]\n");
+   fprintf(stderr, "   -n <MiB>      Replay repeated notes from a cache of this size, with -j 1 [off]\n");
+   return 1;
+}
+
+int main(int argc, const char* argv[])
+{
+   unsigned    program  = 1;
+   unsigned    channel  = 0;
+   unsigned    threads  = 1;
+   double      seconds  = 0.0;
+   unsigned    cache_mb = 0;
+   const char* midi_in  = nullptr;
+   const char* wav_out  = nullptr;
+
+   for(int i = 1; i < argc; ++i)
+   {
+      if ((strcmp(argv[i], "-p") == 0) && ((i + 1) < argc))
+         program = atoi(argv[++i]);
+      else if ((strcmp(argv[i], "-c") == 0) && ((i + 1) < argc))
+         channel = atoi(argv[++i]);
+      else if ((strcmp(argv[i], "-j") == 0) && ((i + 1) < argc))
+         threads = atoi(argv[++i]);
+      else if ((strcmp(argv[i], "-s") == 0) && ((i + 1) < argc))
+         seconds = atof(argv[++i]);
+      else if ((strcmp(argv[i], "-n") == 0) && ((i + 1) < argc))
+         cache_mb = atoi(argv[++i]);
+      else if (midi_in == nullptr)
+         midi_in = argv[i];
+      else if (wav_out == nullptr)
+         wav_out = argv[i];
+      else
+         return usage(argv[0]);
+   }
+
+   if ((wav_out == nullptr) || (program < 1) || (program > 128) || (channel > 16) ||
+       (threads < 1) || (threads > RenderPool::MAX_WORKERS) || (seconds < 0.0) ||
+       ((cache_mb != 0) && (threads != 1)))
+      return usage(argv[0]);
+
+   MidiFile midi_file;
+
+   if (not midi_file.load(midi_in, DAC_FREQ))
+   {
+      fprintf(stderr, "ERROR: failed to read MIDI file \"%s\"\n", midi_in);
+      return 1;
+   }
+
+   WavFile wav_file{DAC_FREQ};
+
+   if (not wav_file.open(wav_out))
+   {
+      fprintf(stderr, "ERROR: failed to create WAV file \"%s\"\n", wav_out);
+      return 1;
+   }
+
+   // Each thread renders its voices between events into its own part of
+   // scratch, the parts are summed in a fixed order
+   RenderPool           pool{threads};
+   std::vector<int32_t> scratch(threads * BLOCK);
+
+   std::unique_ptr<NoteCache> note_cache;
+   if (cache_mb != 0)
+      note_cache.reset(new NoteCache{size_t(cache_mb) << 20});
+
+   auto start = std::chrono::steady_clock::now();
+
+   dx7.init();
+   dx7.setTickRate(DAC_FREQ, TICK_RATE);
+   dx7.setEventTime(0);
+   dx7.programChange(0, program - 1);
+
+   const auto& events = midi_file.getEvents();
+   uint32_t    end    = midi_file.getLength() + TAIL_SECONDS * DAC_FREQ;
+   size_t      next   = 0;
+
+   // Samples before the seek point are skipped, not rendered, the output
+   // from the seek point is the same as from a render of the whole file
+   uint32_t seek = uint32_t(seconds * DAC_FREQ);
+   if (seek > end)
+      seek = end;
+
+   for(uint32_t time = 0; time < end; )
+   {
+      uint32_t block_end = end - time < BLOCK ? end : time + BLOCK;
+
+      if ((time < seek) && (block_end > seek))
+         block_end = seek;
+
+      // Queue the events for this block, the block ends early at an event
+      // that fills the synth event queue. The synth holds the events that
+      // did not fit until the start of the next block, which is their time
+      dx7.flushEvents();
+
+      for(; (next < events.size()) && (events[next].time < block_end); ++next)
+      {
+         const MidiFile::Event& event = events[next];
+
+         if ((channel != 0) && ((event.status & 0xF) != (channel - 1)))
+            continue;
+
+         dx7.setEventTime(event.time);
+
+         if (not dx7.tryQueue([&event]{ sendEvent(event); }))
+         {
+            block_end = event.time > time ? event.time : time + 1;
+            ++next;
+            break;
+         }
+      }
+
+      int32_t  mix[BLOCK];
+      int16_t  pcm[BLOCK];
+      unsigned n = block_end - time;
+
+      if (time < seek)
+      {
+         dx7.skip(n);
+         time = block_end;
+         continue;
+      }
+
+      if (note_cache)
+         dx7.renderCached(*note_cache, mix, n);
+      else if (threads == 1)
+         dx7.render(mix, n);
+      else
+         dx7.renderByVoice(pool, mix, n, scratch.data());
+
+      for(unsigned i = 0; i < n; ++i)
+      {
+         pcm[i] = mix[i] > INT16_MAX ? INT16_MAX
+                : mix[i] < INT16_MIN ? INT16_MIN
+                                     : mix[i];
+      }
+
+      wav_file.write(pcm, n);
+
+      time = block_end;
+   }
+
+   if (not wav_file.close())
+   {
+      fprintf(stderr, "ERROR: failed to write WAV file \"%s\"\n", wav_out);
+      return 1;
+   }
+
+   std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+   double audio_seconds = double(end - seek) / DAC_FREQ;
+
+   printf("%s: %.1f s of audio in %.2f s, %.1fx real-time\n",
+          wav_out, audio_seconds, elapsed.count(), audio_seconds / elapsed.count());
+
+   if (note_cache)
+   {
+      printf("note cache: %u hits, %u misses, %.1f MiB\n",
+             note_cache->hits, note_cache->misses, note_cache->getBytes() / double(1 << 20));
+   }
+
+   return 0;
+}